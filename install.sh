@@ -9,6 +9,9 @@ VERSION="0.0.1"
 # Define default installation path
 DEF_PATH="/usr/local/bin"
 
+# Define the source tree, which holds this script
+SRC_DIR=$(cd "$(dirname "$0")" && pwd)
+
 # Detect the operating system
 OS=$(uname)
 
@@ -85,24 +88,40 @@ if [[ "$INPUT" =~ ^[yY]$ ]]; then
         IN_PATH=$DEF_PATH
     fi
 
+    # The library and the header go next to the binary path, e.g. /usr/local/lib and /usr/local/include
+    PREFIX_PATH=$(dirname "$IN_PATH")
+    LIB_PATH="$PREFIX_PATH/lib"
+    INCLUDE_PATH="$PREFIX_PATH/include"
+
     echo -e "\n${OPSING^} $NAME $VERSION"
 
-    # Copy the binary to the path
-    echo -e "$(echo -e "\u2514\u2500") Copying the $NAME $VERSION binary..."
+    # Build the binary and the library from the source tree
+    echo -e "$(echo -e "\u2514\u2500") Building the $NAME $VERSION binary and library..."
+
+    if ! make -C "$SRC_DIR"; then
+        echo -e "\nBuilding $NAME $VERSION failed, nothing was ${OPSED}"
+
+        exit 1
+    fi
+
+    # Copy the binary, the library and the header to the paths
+    echo -e "$(echo -e "\u2514\u2500") Copying the $NAME $VERSION binary, library and header..."
+
+    if ! { sudo mkdir -p "$IN_PATH" "$LIB_PATH" "$INCLUDE_PATH" &&
+           sudo install -m 755 "$SRC_DIR/build/$BIN_NAME" "$IN_PATH/$BIN_NAME" &&
+           sudo install -m 644 "$SRC_DIR/build/libtabstijl.a" "$LIB_PATH/libtabstijl.a" &&
+           sudo install -m 644 "$SRC_DIR/src/tabstijl.hpp" "$INCLUDE_PATH/tabstijl.hpp"; }; then
+        echo -e "\nCopying $NAME $VERSION failed"
+
+        exit 1
+    fi
 
-    sudo chmod +x "$BIN_NAME"
-    sudo cp -p "$BIN_NAME" "$IN_PATH/$BIN_NAME"
-    sleep 1
-    
-    # Make the binary executable
-    echo -e "$(echo -e "\u2514\u2500") Making the $NAME binary executable..."
-    
-    sudo chmod +x "$IN_PATH/$BIN_NAME"
     sleep 1
 
     # Show success message
     echo -e "\n$NAME $VERSION successfully ${OPSED}!"
-    echo -e "\nYou can type '$BIN_NAME -v' or '$BIN_NAME --version' to check the version."
+    echo -e "\nThe library is in '$LIB_PATH/libtabstijl.a' and its header in '$INCLUDE_PATH/tabstijl.hpp'."
+    echo -e "You can type '$BIN_NAME -v' or '$BIN_NAME --version' to check the version."
     echo -e "See the GitHub page at <https://github.com/naufalhanif25/tabstijl.git>"
     
     exit 0
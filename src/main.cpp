@@ -28,7 +28,7 @@
  * 
  * @brief Parses tabular data from standard input and displays it as a formatted table.
  * 
- * This program reads raw character input from `stdin`, tokenizes it based on a user-defined 
+ * This program reads raw input from `stdin` in large blocks, tokenizes it based on a user-defined 
  * whitespace separator (e.g., spaces, tabs, newlines), and structures the input into rows and columns.
  * It then calculates the optimal column widths and renders the output as a styled ASCII/Unicode table 
  * using user-specified styling options.
@@ -42,6 +42,10 @@
  * - Setting header and body text alignment
  * - Setting whitespace separator between columns (e.g., spaces, tabs, newlines)
  * - Dynamic column width alignment with padding
+ *
+ * The tokenizer, layout and rendering engine is the libtabstijl library (`tabstijl.hpp`),
+ * this file holds the command-line tool around it: option parsing, the help text, the
+ * benchmark, the run statistics, the table output driver and the --serve daemon.
  * 
  * @author Naufal Hanif
  * @date 2025
@@ -52,1202 +56,3369 @@
 // --------------------------------------------------
 
 #include <iostream>
-#include <queue>
 #include <sstream>
 #include <iomanip>
 #include <vector>
 #include <string>
+#include <new>
+#include <chrono>
 #include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <deque>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <string_view>
+#include <atomic>
+#include <thread>
 #include <algorithm>
+#include <cmath>
+
+// --------------------------------------------------
+// POSIX Includes
+// --------------------------------------------------
+
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <signal.h>
+
+// --------------------------------------------------
+// Library Includes
+// --------------------------------------------------
+
+#include "tabstijl.hpp"
+#include "tabstijl_cli.hpp"
 
 // Namespace declarations
 using namespace std;  // Use standard namespace for simplicity in CLI utilities
+using namespace tabstijl;
 
 // Program identity
 #define PROGRAM_NAME "tabstijl"    // Name of the program shown in help/version
 #define PROGRAM_VERSION "0.0.1"  // Semantic version of the CLI tool
 
+// Live mode
+#define LIVE_SAMPLE_ROWS 20  // Rows sampled to fix the column widths in live mode
+
+// Server mode
+#define SERVE_CACHE_SIZE 64           // Distinct argument lists whose parsed options --serve keeps
+#define SERVE_MESSAGE_SIZE (1 << 16)  // Largest argument list sent by --client, in bytes
+#define SERVE_FD_COUNT 4              // Descriptors sent by --client: stdin, stdout, stderr and directory
+#define SERVE_RECEIVE_TIMEOUT_MS 1000 // Time a connected --client has to send its run before it is dropped
+#define SERVE_SOCKET_MODE 0600        // Permissions of the --serve socket, which --client requires
+
+// Watch mode
+#define WATCH_INTERVAL 2.0  // Seconds between the runs of the --watch command
+
+// Default synthetic table generated by --bench
+#define BENCH_ROWS 100000     // Number of generated lines
+#define BENCH_COLS 8          // Number of cells per generated line
+#define BENCH_CELL_LENGTH 12  // Number of characters per generated cell
+#define BENCH_STARTUP_RUNS 200  // Number of processes spawned to measure the startup latency
+#define BENCH_RUNS 3            // Runs of every configuration, the fastest run of each phase being reported
+#define BENCH_TOLERANCE 10      // Percent of throughput a phase may lose against the --bench-baseline report
+#define BENCH_GATE_SECONDS 0.005  // Phases shorter than this are too noisy to be compared to the baseline
+
 // --------------------------------------------------
-// ANSI Color and Text Style Escape Sequences
+// Benchmark
 // --------------------------------------------------
 
-// Text styles
-#define BOLD "\e[1m"
-#define DEFAULT "\e[0m"
-#define INVERSE "\e[7m"
-#define ITALIC "\e[3m"
-#define STRIKETHROUGH "\e[9m"
-#define UNDERLINE "\e[4m"
-
-// Text colors
-#define BLACK "\e[30m"
-#define BLUE "\e[34m"
-#define CYAN "\e[36m"
-#define GREEN "\e[32m"
-#define MAGENTA "\e[35m"
-#define RED "\e[31m"
-#define WHITE "\e[37m"
-#define YELLOW "\e[33m"
-
-// Background colors
-#define BG_BLACK "\e[40m"
-#define BG_BLUE "\e[44m"
-#define BG_CYAN "\e[46m"
-#define BG_GREEN "\e[42m"
-#define BG_MAGENTA "\e[45m"
-#define BG_RED "\e[41m"
-#define BG_WHITE "\e[47m"
-#define BG_YELLOW "\e[43m"
-
-// Whitespace characters
-#define NEWLINE '\n'
-#define SPACE ' '
-#define TAB '\t'
-#define VOID '\0'
-
-// Text alignments
-#define ALIGN_LEFT "left"
-#define ALIGN_CENTER "center"
-#define ALIGN_RIGHT "right"
-
-// Define the border style structs
-// Top border style struct
-typedef struct border_top {
-    string left_char_unicode;
-    string mid_char_unicode;
-    string right_char_unicode;
-    string fill_char_unicode;
-} border_top;
-
-// Middle/separator border style struct
-typedef struct border_separator {
-    string left_char_unicode;
-    string mid_char_unicode;
-    string right_char_unicode;
-    string fill_char_unicode;
-} border_separator;
-
-// Bottom border style struct
-typedef struct border_bottom {
-    string left_char_unicode;
-    string mid_char_unicode;
-    string right_char_unicode;
-    string fill_char_unicode;
-} border_bottom;
-
-// Table border style struct
-typedef struct tab_border {
-    border_top top;
-    border_separator separator;
-    border_bottom bottom;
-    string vertical_line;
-} tab_border;
+// Number of heap allocations made so far, reported by --bench and --stats
+static atomic<size_t> allocation_count(0);
 
-/**
- * @brief Constructs a single table border row using specified Unicode characters.
- *
- * This function generates a string representing one horizontal border row 
- * (top, separator, or bottom) in a table. It takes into account the width of 
- * each column and the total number of columns. Each cell's border is drawn 
- * using the given fill character and separated using a middle junction character.
- *
- * The resulting string includes the left and right boundary characters, colored 
- * with the provided ANSI color code.
- * 
- * @param max_col_count      The total number of columns in the table.
- * @param col_width          A vector of column widths for each column (includes padding).
- * @param left_char_unicode  The Unicode character used at the left-most edge of the border.
- * @param mid_char_unicode   The Unicode character used between columns (junction point).
- * @param right_char_unicode The Unicode character used at the right-most edge of the border.
- * @param fill_char_unicode  The character used to fill horizontal space in the border line.
- * @param table_color        ANSI color escape sequence to apply to the entire border line.
- * 
- * @return A string representing a complete table border row, terminated with a newline.
- */
-string get_tab_border(
-    const size_t &max_col_count, 
-    const vector<size_t> &col_width, 
-    string left_char_unicode, 
-    string mid_char_unicode, 
-    string right_char_unicode, 
-    string fill_char_unicode,
-    string table_color
-) {    
-    int temp_col_width = 0, max_col_width = 0;
-    
-    ostringstream result_oss;
-
-    // Calculate the total width of the border by summing column widths
-    for (size_t index = 0; index < col_width.size(); index++) max_col_width += col_width[index];
-
-    max_col_width -= col_width.size() - 1;  // Adjust for junctions
-
-    result_oss << table_color;  // Apply color to the border
-    result_oss << left_char_unicode;
-    
-    for (size_t st_index = 0; st_index < max_col_count; ++st_index) {
-        temp_col_width += col_width[st_index] - 1;
-
-        for (size_t nd_index = 0; nd_index < col_width[st_index]; ++nd_index) {
-            result_oss << fill_char_unicode;
-            
-            // Insert a mid junction character between columns when appropriate
-            if (nd_index == col_width[st_index] - 1 && temp_col_width < max_col_width - 1) result_oss << mid_char_unicode;
-        }
-    }
-    
-    result_oss << right_char_unicode << DEFAULT << endl;
+// Counting replacements of the global allocation functions
+void *operator new(size_t size) {
+    allocation_count.fetch_add(1, memory_order_relaxed);
+
+    if (void *block = malloc(size ? size : 1)) return block;
+
+    throw bad_alloc();
+}
 
-    return result_oss.str();
+// Kept out of line, so that GCC does not pair an inlined free() with operator new (-Wmismatched-new-delete)
+__attribute__((noinline)) void operator delete(void *block) noexcept {
+    free(block);
 }
 
+__attribute__((noinline)) void operator delete(void *block, size_t) noexcept {
+    free(block);
+}
+
+// Environment passed on to the processes spawned by --bench
+extern char **environ;
+
+// Benchmark configuration struct
+typedef struct bench_variant {
+    string name;                        // Label of the configuration in the report
+    tab_render_options render_options;  // The styling and border configuration under test
+    char col_separator;                 // The column delimiter of the generated input
+} bench_variant;
+
+// Measurements of one benchmark phase
+typedef struct bench_phase {
+    double seconds;      // Wall clock time spent in the phase
+    size_t allocations;  // Heap allocations made during the phase
+} bench_phase;
+
+// Benchmark phases, in the order of the report
+static constexpr const char *BENCH_PHASE_NAMES[] = { "parse", "width", "render" };
+
+// Throughput of one benchmarked configuration, as compared by --bench-baseline
+typedef struct bench_throughput {
+    string name;          // Label of the configuration in the report
+    double seconds[3];    // Wall clock time of each phase, in the order of BENCH_PHASE_NAMES
+    double mb_per_s[3];   // Throughput of each phase
+} bench_throughput;
+
 /**
- * @brief Checks whether a string begins with a specified prefix.
+ * @brief Maps a column delimiter to its --separator name.
  *
- * This utility function is used to verify if `domain_string` starts with
- * the content of `string_to_find`. It performs a prefix match from index 0.
+ * @param col_separator  The column delimiter.
  *
- * @param domain_string    The full string in which to search.
- * @param string_to_find   The prefix string to search for.
- * 
- * @return true if `domain_string` starts with `string_to_find`, false otherwise.
+ * @return The name accepted by the --separator option.
  */
-bool starts_with(const string &domain_string, const string &string_to_find) {
-    return domain_string.rfind(string_to_find, 0) == 0;
+string get_separator_name(const char &col_separator) {
+    if (col_separator == NEWLINE) return "newln";
+    else if (col_separator == TAB) return "tab";
+    else if (col_separator == VOID) return "wspace";
+
+    return "space";
 }
 
 /**
- * @brief Determines whether a character is considered a column separator or whitespace.
+ * @brief Generates a synthetic table of random alphanumeric cells.
  *
- * This function evaluates if the given character qualifies as a field delimiter
- * based on the selected `col_separator`. If `col_separator` is one of the standard
- * whitespace characters, it is treated explicitly. Otherwise, fallback to checking
- * general whitespace using `isspace()`.
+ * The output is the same for the same arguments, so runs can be compared over time.
  *
- * @param current_char     The character to evaluate.
- * @param col_separator    The user-defined or default column delimiter.
- * 
- * @return true if the character is a recognized whitespace or matches the delimiter.
+ * @param row_count      Number of lines to generate.
+ * @param col_count      Number of cells per line.
+ * @param cell_length    Number of characters per cell.
+ * @param col_separator  The column delimiter placed between cells (spaces for "wspace").
+ *
+ * @return The generated input.
  */
-bool is_wspace(
-    const char &current_char,
+string generate_bench_input(
+    const size_t &row_count,
+    const size_t &col_count,
+    const size_t &cell_length,
     const char &col_separator
 ) {
-    vector<char> separators = { NEWLINE, SPACE, TAB };
+    static const char cell_chars[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+
+    char cell_separator = col_separator == VOID ? SPACE : col_separator;
+    uint64_t random_state = 0x9E3779B97F4A7C15ULL;
 
-    if (find(separators.begin(), separators.end(), col_separator) != separators.end()) {
-        separators.clear();
+    string input;
 
-        return current_char == col_separator || current_char == NEWLINE;
-    } else {
-        separators.clear();
+    input.reserve(row_count * col_count * (cell_length + 1));
 
-        return isspace(current_char);
+    for (size_t row_index = 0; row_index < row_count; ++row_index) {
+        for (size_t col_index = 0; col_index < col_count; ++col_index) {
+            for (size_t char_index = 0; char_index < cell_length; ++char_index) {
+                // xorshift64
+                random_state ^= random_state << 13;
+                random_state ^= random_state >> 7;
+                random_state ^= random_state << 17;
+
+                input += cell_chars[random_state % (sizeof(cell_chars) - 1)];
+            }
+
+            input += col_index + 1 < col_count ? cell_separator : NEWLINE;
+        }
     }
+
+    return input;
 }
 
 /**
- * @brief Aligns a given string within a specified column width based on the desired alignment.
- *
- * This function takes a string and formats it within a given width, aligning it either 
- * to the left, center, or right. It pads the string with spaces accordingly and returns 
- * a pair containing the original column width and the formatted (aligned) string.
+ * @brief Writes the measurements of one phase as a JSON object.
  *
- * @param string_to_align     The text content to align.
- * @param tab_col_width       The width of the column the text should fit into.
- * @param text_alignment      The alignment directive: "left", "center", or "right". Defaults to "left".
- * 
- * @return pair<size_t, string> A pair containing:
- *                              - The column width (as a `size_t`)
- *                              - The aligned string with space-padding as needed
+ * @param report      The stream receiving the JSON.
+ * @param phase       The measurements of the phase.
+ * @param byte_count  Number of bytes the phase consumed or produced.
+ * @param row_count   Number of rows the phase processed.
  */
-pair<size_t, string> align_text(
-    string string_to_align,
-    size_t tab_col_width,
-    string text_alignment = ALIGN_LEFT
+void write_bench_phase(
+    ostream &report,
+    const bench_phase &phase,
+    const size_t &byte_count,
+    const size_t &row_count
 ) {
-    // Output stream to accumulate the final aligned string
-    ostringstream result_oss;
+    double seconds = max(phase.seconds, 1e-9);
+
+    report << "{ \"seconds\": " << phase.seconds
+           << ", \"mb_per_s\": " << byte_count / seconds / 1e6
+           << ", \"rows_per_s\": " << row_count / seconds
+           << ", \"allocations\": " << phase.allocations << " }";
+}
+
+/**
+ * @brief Measures the startup latency of the program.
+ *
+ * The running executable is spawned `run_count` times on an empty input, one process at
+ * a time, with the output discarded. This is the per-invocation cost of short-lived runs.
+ *
+ * @param run_count  Number of processes to spawn.
+ *
+ * @return The mean wall clock time of one invocation in seconds, or -1 on failure.
+ */
+double bench_startup(const size_t &run_count) {
+    typedef chrono::steady_clock bench_clock;
 
-    size_t string_length = string_to_align.length();
+    posix_spawn_file_actions_t file_actions;
 
-    // Handle right alignment
-    if (text_alignment == ALIGN_RIGHT) {
-        // Calculate the number of leading spaces required
-        size_t col_padding = tab_col_width > string_length ? tab_col_width - string_length : 0;
+    posix_spawn_file_actions_init(&file_actions);
+    posix_spawn_file_actions_addopen(&file_actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_addopen(&file_actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
 
-        // Append leading spaces followed by the original string
-        result_oss << string(col_padding, SPACE) << string_to_align;
-        
-        return { tab_col_width, result_oss.str() };
-    }
-    // Handle center alignment
-    else if (text_alignment == ALIGN_CENTER) {
-        // Calculate the total padding required
-        size_t col_total_padding = tab_col_width > string_length ? tab_col_width - string_length : 0;
+    char program_name[] = PROGRAM_NAME;
+    char *spawn_argv[] = { program_name, NULL };
 
-        // Divide the total padding into left and right padding
-        size_t col_left_padding = col_total_padding / 2;
-        size_t col_right_padding = col_total_padding - col_left_padding;
+    bench_clock::time_point bench_start = bench_clock::now();
 
-        // Append left padding, the string, then right padding
-        result_oss << string(col_left_padding, ' ') << string_to_align << string(col_right_padding, SPACE);
+    for (size_t run_index = 0; run_index < run_count; ++run_index) {
+        pid_t child_pid;
+        int child_status;
 
-        return { tab_col_width, result_oss.str() };
-    }
-    // Default to left alignment
-    else {
-        // Append the original string followed by trailing spaces
-        result_oss << string_to_align << string(tab_col_width > string_length ? tab_col_width - string_length : 0, SPACE);
-        
-        return { tab_col_width, result_oss.str() };
+        if (posix_spawn(&child_pid, "/proc/self/exe", &file_actions, NULL, spawn_argv, environ) != 0 || waitpid(child_pid, &child_status, 0) < 0) {
+            posix_spawn_file_actions_destroy(&file_actions);
+
+            return -1;
+        }
     }
+
+    double bench_seconds = chrono::duration<double>(bench_clock::now() - bench_start).count();
+
+    posix_spawn_file_actions_destroy(&file_actions);
+
+    return bench_seconds / max(run_count, static_cast<size_t>(1));
 }
 
 /**
- * @brief Clears all Unicode border characters in a given tab_border structure.
- * 
- * This function deletes all string values used to define the boundary component to minimise memory usage.
- * 
- * The structure includes definitions for the top, separator (between header and body),
- * and bottom border lines, as well as the vertical line between columns.
- * 
- * @param tab_border_struct A reference to the tab_border struct containing border characters.
+ * @brief Reads the sizes and the phase throughputs back from a --bench report.
+ *
+ * Only the reports written by `run_bench()` are understood: the members are looked up by
+ * name in the order they are written, so no general JSON parser is needed.
+ *
+ * @param report       The text of the report.
+ * @param sizes        Receives the rows, columns and cell length of the generated table.
+ * @param throughputs  Receives the throughput of every configuration of the report.
+ *
+ * @return `false` if the text is not a --bench report, `true` otherwise.
  */
-void clear_tab_border(tab_border &tab_border_struct) {
-    // Clear bottom border characters
-    tab_border_struct.bottom.fill_char_unicode.clear();
-    tab_border_struct.bottom.left_char_unicode.clear();
-    tab_border_struct.bottom.mid_char_unicode.clear();
-    tab_border_struct.bottom.right_char_unicode.clear();
+bool read_bench_report(
+    const string &report,
+    size_t sizes[3],
+    vector<bench_throughput> &throughputs
+) {
+    size_t position = 0;
 
-    // Clear separator line characters (between header and body)
-    tab_border_struct.separator.fill_char_unicode.clear();
-    tab_border_struct.separator.left_char_unicode.clear();
-    tab_border_struct.separator.mid_char_unicode.clear();
-    tab_border_struct.separator.right_char_unicode.clear();
+    // Reads the number of the next member with the given name, moving past it
+    auto read_member = [&](const string &member_name, double &value) {
+        size_t member_position = report.find("\"" + member_name + "\": ", position);
 
-    // Clear top border characters
-    tab_border_struct.top.fill_char_unicode.clear();
-    tab_border_struct.top.left_char_unicode.clear();
-    tab_border_struct.top.mid_char_unicode.clear();
-    tab_border_struct.top.right_char_unicode.clear();
+        if (member_position == string::npos) return false;
 
-    // Clear vertical line character (used between cells in rows)
-    tab_border_struct.vertical_line.clear();
-}
+        const char *value_begin = report.c_str() + member_position + member_name.length() + 4;
+        char *value_end;
 
-int main(
-    int argc, 
-    char *argv[]
-) {
-    // Table formatting and parsing flags
-    bool headerless = false;               // Disable table header rendering
-    bool exclude_first_line = headerless;  // Whether to skip the first input line during processing
-    bool first_line = true;                // Flag to indicate current parsing line is the first
-    bool use_border = true;                // Enable table border rendering output
-    bool use_separator = true;             // Enable a horizontal line separator between header and body
-
-    // ANSI Color and style configuration for table elements
-    string table_color;                     // Color for the outer table border
-    string header_text_color;               // Text color used for header row
-    string body_text_color;                 // Text color used for body rows
-    string header_bg_color;                 // Background color for header row
-    string body_bg_color;                   // Background color for body rows
-    string header_text_style;               // Text style for header row
-    string body_text_style;                 // Text style for body rows
-    string header_text_align = ALIGN_LEFT;  // Text aligmnet for header rows
-    string body_text_align = ALIGN_LEFT;    // Text aligmnet for body rows
+        value = strtod(value_begin, &value_end);
+        position = value_end - report.c_str();
 
-    vector<string> usrinput_header_data;  // Holds the header data from user input
+        return value_end != value_begin;
+    };
 
-    // Column separator character
-    char col_separator = SPACE;  // A character used to separate the header and body rows of the table
+    const char *size_names[] = { "rows", "columns", "cell_length" };
 
-    // Default single-line table border style using Unicode characters
-    tab_border tab_border_style = {
-        { "\u250C", "\u252C", "\u2510", "\u2500" },  // Top border: left, mid, right, horizontal line
-        { "\u251C", "\u253C", "\u2524", "\u2500" },  // Separator: left, mid, right, horizontal line
-        { "\u2514", "\u2534", "\u2518", "\u2500" },  // Bottom border: left, mid, right, horizontal line
-        "\u2502"                                     // Vertical line between columns
-    };
+    for (size_t index = 0; index < 3; ++index) {
+        double size_value;
 
-    // Optional double-line border style
-    tab_border double_border_style = {
-        { "\u2554", "\u2566", "\u2557", "\u2550" },
-        { "\u2560", "\u256C", "\u2563", "\u2550" },
-        { "\u255A", "\u2569", "\u255D", "\u2550" },
-        "\u2551"
-    };
+        if (!read_member(size_names[index], size_value)) return false;
 
-    // Optional heavy-line border style
-    tab_border heavy_border_style = {
-        { "\u250F", "\u2533", "\u2513", "\u2501" },
-        { "\u2523", "\u254B", "\u252B", "\u2501" },
-        { "\u2517", "\u253B", "\u251B", "\u2501" },
-        "\u2503"
-    };
+        sizes[index] = static_cast<size_t>(size_value);
+    }
 
-    // Optional star border style
-    tab_border star_border_style = {
-        { "\u2732", "\u2732", "\u2732", "\u2732" },
-        { "\u2732", "\u2732", "\u2732", "\u2732" },
-        { "\u2732", "\u2732", "\u2732", "\u2732" },
-        "\u2551"
-    };
+    throughputs.clear();
 
-    // Left padding around table columns
-    int col_padding = 2;  // Number of spaces added on each side of a table cell value
-
-    string PROGRAM_LOGO = "\t\t _____     _   _____ _   _   _ _ \n"
-                          "\t\t|_   _|___| |_|   __| |_|_| |_| |\n"
-                          "\t\t  | | | .'| . |__   |  _| | | | |\n"
-                          "\t\t  |_| |__,|___|_____|_| |_|_| |_|\n"
-                          "\t\t                          |___|  \n";
-
-    // Command-line usage and help guide
-    string HELP_MESSAGE = 
-        "Usage: [program] [...OPTIONS]\n\n"
-        "OPTIONS\n"
-        "      --bbg-color=COLOR       Set body background color\n"
-        "                              Available background colors:\n"
-        "                                - black     - blue\n"
-        "                                - cyan      - green\n"
-        "                                - magenta   - red\n"
-        "                                - white     - yellow\n"
-        "                              Example:\n"
-        "                                --bbg-color=green  # sets the body background color to green\n"
-        "      --bg-color=COLOR        Set header and body background color\n"
-        "                              Available background colors:\n"
-        "                                - black     - blue\n"
-        "                                - cyan      - green\n"
-        "                                - magenta   - red\n"
-        "                                - white     - yellow\n"
-        "                              Example:\n"
-        "                                --text-color=cyan  # sets the background color to cyan\n"
-        "-b or --borderless            Hide table border\n"
-        "      --border-style=STYLE    Set border style\n"
-        "                              Available border styles:\n"
-        "                                - double  # Double line border style\n"
-        "                                - heavy   # Heavy line border style\n"
-        "                                - star\n"
-        "                              Example:\n"
-        "                                --border-style=heavy  # sets the border style to heavy line\n"
-        "      --btext-align=ALIGN     Set body text alignment\n"
-        "                              Available alignments:\n"
-        "                                - left\n"
-        "                                - center\n"
-        "                                - right\n"
-        "                              Example:\n"
-        "                                --btext-align=left  # sets the body text alignment to left\n"
-        "      --btext-color=COLOR     Set body text color\n"
-        "                              Available text colors:\n"
-        "                                - black     - blue\n"
-        "                                - cyan      - green\n"
-        "                                - magenta   - red\n"
-        "                                - white     - yellow\n"
-        "                              Example:\n"
-        "                                --btext-color=red  # sets the body text color to red\n"
-        "      --btext-style=STYLE     Set body text style\n"
-        "                              Available text styles:\n"
-        "                                - bold      - inverse\n"
-        "                                - italic    - strike\n"
-        "                                - underline\n"
-        "                              Example:\n"
-        "                                --btext-style=bold  # sets the body text style to bold\n"
-        "-f or --fusion                Hide the separator between header and body\n"
-        "      --hbg-color=COLOR       Set header background color\n"
-        "                              Available background colors:\n"
-        "                                - black     - blue\n"
-        "                                - cyan      - green\n"
-        "                                - magenta   - red\n"
-        "                                - white     - yellow\n"
-        "                              Example:\n"
-        "                                --hbg-color=green  # sets the header background color to green\n"
-        "      --hdata                 Set header data (columns name)\n"
-        "                              Example:\n"
-        "                                --hdata=permission,username,group,size,filename  # each column name separated by a comma\n"
-        "-h or --help                  Show help message\n"
-        "      --htext-align=ALIGN     Set header text alignment\n"
-        "                              Available alignments:\n"
-        "                                - left\n"
-        "                                - center\n"
-        "                                - right\n"
-        "                              Example:\n"
-        "                                --htext-align=center  # sets the header text alignment to center\n"
-        "      --htext-color=COLOR     Set header text color\n"
-        "                              Available text colors:\n"
-        "                                - black     - blue\n"
-        "                                - cyan      - green\n"
-        "                                - magenta   - red\n"
-        "                                - white     - yellow\n"
-        "                              Example:\n"
-        "                                --htext-color=red  # sets the header text color to red\n"
-        "      --htext-style=STYLE     Set header text style\n"
-        "                              Available text styles:\n"
-        "                                - bold      - inverse\n"
-        "                                - italic    - strike\n"
-        "                                - underline\n"
-        "                              Example:\n"
-        "                                --htext-style=bold  # sets the header text style to bold\n"
-        "      --padding=VALUE         Set column padding\n"
-        "                              Example:\n"
-        "                                --padding=8  # padding 8 spaces to left\n"
-        "      --separator             Set column separator\n"
-        "                              Available separators:\n"
-        "                                - newln   # Newline\n"
-        "                                - space\n"
-        "                                - tab\n"
-        "                                - wspace  # every whitespace\n"
-        "                              Example:\n"
-        "                                --separator=wspace  # sets the separator to whitespace\n"
-        "-s or --simplify              Show table in simple form (without header)\n"
-        "      --tab-color=COLOR       Set table border color\n"
-        "                              Available table border colors:\n"
-        "                                - black     - blue\n"
-        "                                - cyan      - green\n"
-        "                                - magenta   - red\n"
-        "                                - white     - yellow\n"
-        "                              Example:\n"
-        "                                --tab-color=yellow  # sets the border color to yellow\n"
-        "      --text-align=ALIGN      Set header and body text alignment\n"
-        "                              Available alignments:\n"
-        "                                - left\n"
-        "                                - center\n"
-        "                                - right\n"
-        "                              Example:\n"
-        "                                --text-align=right  # sets the text alignment to right\n"
-        "      --text-color=COLOR      Set header and body text color\n"
-        "                              Available text colors:\n"
-        "                                - black     - blue\n"
-        "                                - cyan      - green\n"
-        "                                - magenta   - red\n"
-        "                                - white     - yellow\n"
-        "                              Example:\n"
-        "                                --text-color=red  # sets the text color to red\n"
-        "      --text-style=STYLE      Set header and body text style\n"
-        "                              Available text styles:\n"
-        "                                - bold      - inverse\n"
-        "                                - italic    - strike\n"
-        "                                - underline\n"
-        "                              Example:\n"
-        "                                --text-style=underline  # sets the text style to underline\n"
-        "      --theme=THEME           Set table theme\n"
-        "                              Available themes:\n"
-        "                                - matrix    - mecha\n"
-        "                                - myth      - retro\n"
-        "                                - sticky\n"
-        "                              Example:\n"
-        "                                --theme=matrix  # sets the theme to matrix\n"
-        "-v or --version               Show [program] version\n\n"
-        "See the GitHub page at <https://github.com/naufalhanif25/tabstijl.git>\n";
+    for (size_t name_position; (name_position = report.find("\"name\": \"", position)) != string::npos;) {
+        size_t name_begin = name_position + 9;
+        size_t name_end = report.find('"', name_begin);
 
-    // --------------------------------------------------
-    // Option Handlers
-    // --------------------------------------------------
+        if (name_end == string::npos) return false;
 
-    // Loop through all command-line arguments
-    for (int index = 1; index < argc; index++) {
-        const string option = static_cast<string>(argv[index]);
+        bench_throughput throughput;
+
+        throughput.name = report.substr(name_begin, name_end - name_begin);
+        position = name_end;
 
-        // Handle configuration of -b or --borderless options
-        // Disables table borders entirely
-        if (option == "-b" || option == "--borderless") {
-            use_border = false;
+        // Each phase is an object holding its seconds and its throughput
+        for (size_t phase_index = 0; phase_index < 3; ++phase_index) {
+            if ((position = report.find("\"" + string(BENCH_PHASE_NAMES[phase_index]) + "\": {", position)) == string::npos) return false;
 
-            continue;
+            if (!read_member("seconds", throughput.seconds[phase_index]) || !read_member("mb_per_s", throughput.mb_per_s[phase_index])) return false;
         }
-        // Handle configuration of --border-style option
-        // Sets table border style configuration
-        else if (starts_with(option, "--border-style")) {
-            size_t equal_sign_pos = option.find("=");
-            string option_key = option;
-
-            if (equal_sign_pos != string::npos) {
-                string option_value = option.substr(equal_sign_pos + 1);
-
-                if (option_value == "double") tab_border_style = double_border_style;
-                else if (option_value == "heavy") tab_border_style = heavy_border_style;
-                else if (option_value == "star") tab_border_style = star_border_style;
-                else {
-                    // Handle invalid border style value
-                    cerr << "Error: Invalid '" << option_value << "' value in '" << option_key << "' option" << endl << endl;
-                    cerr << "Type '-h' or '--help' to show the help message" << endl;
-
-                    return 1;  // Exit with error
-                }
 
-                continue;
-            }
-            else {
-                // Handle missing '=' and value
-                cerr << "Error: The '" << option_key << "' option has no value assigned" << endl << endl;
-                cerr << "Type '-h' or '--help' to show the help message" << endl;
+        throughputs.push_back(throughput);
+    }
 
-                return 1;  // Exit with error
-            }
-        }
-        // Handle configuration of -f or --fusion options
-        // Disables column separation
-        else if (option == "-f" || option == "--fusion") {
-            use_separator = false;
+    return !throughputs.empty();
+}
 
-            continue;
-        }
-        // Handle configuration of --hdata option
-        // Sets the header data
-        else if (
-            starts_with(option, "--hdata")
-        ) {
-            size_t equal_sign_pos = option.find("=");
-            string option_key = option;
+/**
+ * @brief Compares the measured throughputs to those of a saved --bench report.
+ *
+ * A phase fails when its throughput dropped by more than `tolerance` percent. Phases that
+ * took less than `BENCH_GATE_SECONDS` in either run are skipped, as are configurations
+ * missing from the baseline. Every failing phase is reported on stderr.
+ *
+ * @param baseline_path  The saved report.
+ * @param tolerance      Percent of throughput a phase may lose.
+ * @param sizes          The rows, columns and cell length of the measured table.
+ * @param throughputs    The measured throughput of every configuration.
+ *
+ * @return The process exit status, 1 if a phase got slower or the baseline is unusable.
+ */
+int check_bench_baseline(
+    const string &baseline_path,
+    const double &tolerance,
+    const size_t sizes[3],
+    const vector<bench_throughput> &throughputs
+) {
+    int baseline_fd = open(baseline_path.c_str(), O_RDONLY);
 
-            if (equal_sign_pos != string::npos) {
-                option_key = option.substr(0, equal_sign_pos);
+    if (baseline_fd < 0) {
+        cerr << "Error: Unable to open '" << baseline_path << "': " << strerror(errno) << endl;
 
-                string option_value = option.substr(equal_sign_pos + 1);
+        return 1;  // Exit with error
+    }
 
-                // Map received header data strings
-                if (option_value != "\0") {
-                    string option_value_token;
-                    stringstream option_value_ss (option_value);
+    vector<char> baseline_bytes;
 
-                    while (getline(option_value_ss, option_value_token, ',')) usrinput_header_data.push_back(option_value_token);
-                }
-                else {
-                    // Handle invalid value
-                    cerr << "Error: Invalid '" << option_value << "' value in '" << option_key << "' option" << endl << endl;
-                    cerr << "Type '-h' or '--help' to show the help message" << endl;
+    read_all(baseline_fd, baseline_bytes);
+    close(baseline_fd);
 
-                    return 1;  // Exit with error
-                }
+    size_t baseline_sizes[3];
+    vector<bench_throughput> baseline;
 
-                continue;
-            }
-            else {
-                // Handle missing '=' and value
-                cerr << "Error: The '" << option_key << "' option has no value assigned" << endl << endl;
-                cerr << "Type '-h' or '--help' to show the help message" << endl;
+    if (!read_bench_report(string(baseline_bytes.begin(), baseline_bytes.end()), baseline_sizes, baseline)) {
+        cerr << "Error: '" << baseline_path << "' is not a '--bench' report" << endl;
 
-                return 1;  // Exit with error
-            }
-        }
-        // Handle configuration of --htext-align, --btext-align, or --text-align options
-        // Sets the alignment configuration of header or body or both
-        else if (
-            starts_with(option, "--htext-align") || 
-            starts_with(option, "--btext-align") || 
-            starts_with(option, "--text-align")
-        ) {
-            size_t equal_sign_pos = option.find("=");
-            string option_key = option;
-
-            if (equal_sign_pos != string::npos) {
-                option_key = option.substr(0, equal_sign_pos);
-
-                string temp_text_align;
-                string option_value = option.substr(equal_sign_pos + 1);
-                string &target_var = (
-                    option_key == "--text-align" ? temp_text_align : 
-                    option_key == "--htext-align" ? header_text_align : 
-                    body_text_align
-                );
-
-                // Map received text alignment strings to text alignment constants
-                if (option_value == ALIGN_LEFT) target_var = ALIGN_LEFT;
-                else if (option_value == ALIGN_CENTER) target_var = ALIGN_CENTER;
-                else if (option_value == ALIGN_RIGHT) target_var = ALIGN_RIGHT;
-                else {
-                    // Handle invalid value
-                    cerr << "Error: Invalid '" << option_value << "' value in '" << option_key << "' option" << endl << endl;
-                    cerr << "Type '-h' or '--help' to show the help message" << endl;
-
-                    return 1;  // Exit with error
-                }
+        return 1;  // Exit with error
+    }
 
-                // Apply same alignment to both header and body if --text-align is used
-                if (!temp_text_align.empty()) {
-                    header_text_align = temp_text_align;
-                    body_text_align = temp_text_align;
-                }
+    if (!equal(sizes, sizes + 3, baseline_sizes)) {
+        cerr << "Error: '" << baseline_path << "' was measured on a table of other sizes (--bench="
+             << baseline_sizes[0] << "," << baseline_sizes[1] << "," << baseline_sizes[2] << ")" << endl;
 
-                continue;
-            }
-            else {
-                // Handle missing '=' and value
-                cerr << "Error: The '" << option_key << "' option has no value assigned" << endl << endl;
-                cerr << "Type '-h' or '--help' to show the help message" << endl;
+        return 1;  // Exit with error
+    }
 
-                return 1;  // Exit with error
-            }
-        }
-        // Handle configuration of --hbg-color, --bbg-color, or --bg-color options
-        // Sets the background color configuration of header or body or both
-        else if (
-            starts_with(option, "--hbg-color") || 
-            starts_with(option, "--bbg-color") || 
-            starts_with(option, "--bg-color")
-        ) {
-            size_t equal_sign_pos = option.find("=");
-            string option_key = option;
-
-            if (equal_sign_pos != string::npos) {
-                option_key = option.substr(0, equal_sign_pos);
-
-                string temp_bg_color;
-                string option_value = option.substr(equal_sign_pos + 1);
-                string &target_var = (
-                    option_key == "--bg-color" ? temp_bg_color : 
-                    option_key == "--hbg-color" ? header_bg_color : 
-                    body_bg_color
-                );
-
-                // Map received color strings to ANSI background color constants
-                if (option_value == "black") target_var = BG_BLACK;
-                else if (option_value == "blue") target_var = BG_BLUE;
-                else if (option_value == "cyan") target_var = BG_CYAN;
-                else if (option_value == "green") target_var = BG_GREEN;
-                else if (option_value == "magenta") target_var = BG_MAGENTA;
-                else if (option_value == "red") target_var = BG_RED;
-                else if (option_value == "white") target_var = BG_WHITE;
-                else if (option_value == "yellow") target_var = BG_YELLOW;
-                else {
-                    // Handle invalid value
-                    cerr << "Error: Invalid '" << option_value << "' value in '" << option_key << "' option" << endl << endl;
-                    cerr << "Type '-h' or '--help' to show the help message" << endl;
-
-                    return 1;  // Exit with error
-                }
+    size_t failure_count = 0;
 
-                // Apply same color to both header and body if --bg-color is used
-                if (!temp_bg_color.empty()) {
-                    header_bg_color = temp_bg_color;
-                    body_bg_color = temp_bg_color;
-                }
+    for (const auto &measured : throughputs) {
+        auto baseline_entry = find_if(baseline.begin(), baseline.end(), [&](const bench_throughput &entry) { return entry.name == measured.name; });
 
-                continue;
-            }
-            else {
-                // Handle missing '=' and value
-                cerr << "Error: The '" << option_key << "' option has no value assigned" << endl << endl;
-                cerr << "Type '-h' or '--help' to show the help message" << endl;
+        if (baseline_entry == baseline.end()) continue;
 
-                return 1;  // Exit with error
-            }
-        }
-        // Handle configuration of --htext-style, --btext-style, or --text-style options
-        // Sets the text style configuration of header or body or both
-        else if (
-            starts_with(option, "--htext-style") || 
-            starts_with(option, "--btext-style") ||
-            starts_with(option, "--text-style")
-        ) {
-            size_t equal_sign_pos = option.find("=");
-            string option_key = option;
-
-            if (equal_sign_pos != string::npos) {
-                option_key = option.substr(0, equal_sign_pos);
-
-                string temp_text_style;
-                string option_value = option.substr(equal_sign_pos + 1);
-                string &target_var = (
-                    option_key == "--text-style" ? temp_text_style :
-                    option_key == "--htext-style" ? header_text_style : 
-                    body_text_style
-                );
-
-                // Map valid style strings to ANSI style constants
-                if (option_value == "bold") target_var = BOLD;
-                else if (option_value == "inverse") target_var = INVERSE;
-                else if (option_value == "italic") target_var = ITALIC;
-                else if (option_value == "strike") target_var = STRIKETHROUGH;
-                else if (option_value == "underline") target_var = UNDERLINE;
-                else {
-                    // Handle invalid value
-                    cerr << "Error: Invalid '" << option_value << "' value in '" << option_key << "' option" << endl << endl;
-                    cerr << "Type '-h' or '--help' to show the help message" << endl;
-
-                    return 1;  // Exit with error
-                }
+        for (size_t phase_index = 0; phase_index < 3; ++phase_index) {
+            double baseline_mb_per_s = baseline_entry->mb_per_s[phase_index];
+            double drop = baseline_mb_per_s > 0 ? (1 - measured.mb_per_s[phase_index] / baseline_mb_per_s) * 100 : 0;
 
-                // Apply same style to both header and body if --text-style is used
-                if (!temp_text_style.empty()) {
-                    header_text_style = temp_text_style;
-                    body_text_style = temp_text_style;
-                }
+            if (min(measured.seconds[phase_index], baseline_entry->seconds[phase_index]) < BENCH_GATE_SECONDS || drop <= tolerance) continue;
 
-                continue;
-            }
-            else {
-                // Handle missing '=' and value
-                cerr << "Error: The '" << option_key << "' option has no value assigned" << endl << endl;
-                cerr << "Type '-h' or '--help' to show the help message" << endl;
+            cerr << "Error: The " << BENCH_PHASE_NAMES[phase_index] << " phase of '" << measured.name << "' dropped " << fixed << setprecision(1) << drop
+                 << "% below the baseline (" << measured.mb_per_s[phase_index] << " MB/s, baseline " << baseline_mb_per_s << " MB/s)" << endl;
 
-                return 1;  // Exit with error
-            }
+            ++failure_count;
+        }
+    }
+
+    return failure_count > 0 ? 1 : 0;
+}
+
+/**
+ * @brief Benchmarks the parse, width and render phases on a synthetic table.
+ *
+ * Every configuration is run `BENCH_RUNS` times, single-threaded, on input generated for its
+ * separator, and the fastest run of each phase is reported.
+ * The parse phase tokenizes the whole input into the cell store, the width phase measures
+ * the columns and compiles the render plan, and the render phase renders the table into
+ * memory. The report is written to stdout as JSON: throughput is relative to the input
+ * bytes for the parse and width phases, and to the output bytes for the render phase.
+ * The peak RSS is that of the process so far. The report also holds the startup latency
+ * measured by `bench_startup()`. With a baseline report, the run then fails when a phase
+ * got slower than it, see `check_bench_baseline()`.
+ *
+ * @param row_count           Number of lines to generate.
+ * @param col_count           Number of cells per line.
+ * @param cell_length         Number of characters per cell.
+ * @param exclude_first_line  Whether tokens of the first input line are dropped.
+ * @param col_padding         Number of spaces added to each column width.
+ * @param variants            The configurations to benchmark.
+ * @param baseline_path       The --bench-baseline report to compare to, or empty.
+ * @param tolerance           Percent of throughput a phase may lose against the baseline.
+ *
+ * @return The process exit status.
+ */
+int run_bench(
+    const size_t &row_count,
+    const size_t &col_count,
+    const size_t &cell_length,
+    const bool &exclude_first_line,
+    const int &col_padding,
+    const vector<bench_variant> &variants,
+    const string &baseline_path,
+    const double &tolerance
+) {
+    typedef chrono::steady_clock bench_clock;
+
+    ostringstream report;
+
+    string input;
+    char input_separator = NEWLINE;
+    vector<bench_throughput> throughputs;
+
+    report << fixed << setprecision(6);
+    report << "{" << NEWLINE;
+    report << "  \"program\": \"" << PROGRAM_NAME << "\"," << NEWLINE;
+    report << "  \"version\": \"" << PROGRAM_VERSION << "\"," << NEWLINE;
+    report << "  \"rows\": " << row_count << "," << NEWLINE;
+    report << "  \"columns\": " << col_count << "," << NEWLINE;
+    report << "  \"cell_length\": " << cell_length << "," << NEWLINE;
+    report << "  \"padding\": " << col_padding << "," << NEWLINE;
+    report << "  \"startup\": { \"runs\": " << BENCH_STARTUP_RUNS << ", \"seconds_per_run\": " << bench_startup(BENCH_STARTUP_RUNS) << " }," << NEWLINE;
+    report << "  \"results\": [" << NEWLINE;
+
+    for (size_t variant_index = 0; variant_index < variants.size(); ++variant_index) {
+        const bench_variant &variant = variants[variant_index];
+
+        if (variant_index == 0 || variant.col_separator != input_separator) {
+            input = generate_bench_input(row_count, col_count, cell_length, variant.col_separator);
+            input_separator = variant.col_separator;
         }
-        // Handle configuration of -h or --help options
-        // Prints help message with program name injected in placeholder
-        else if (option == "-h" || option == "--help") {
-            size_t current_position = 0;
 
-            string str_to_replace = "[program]";
-            string str_target = PROGRAM_NAME;
+        // Fastest run of each phase, the one least disturbed by the rest of the system
+        bench_phase parse_phase = { INFINITY, 0 }, width_phase = { INFINITY, 0 }, render_phase = { INFINITY, 0 };
+        tab_store bench_tab_data = {};
+        size_t tab_row_count = 0;
+        size_t output_bytes = 0;
 
-            while ((current_position = HELP_MESSAGE.find(str_to_replace, current_position)) != string::npos) {
-                HELP_MESSAGE.replace(current_position, str_to_replace.length(), str_target);
+        for (size_t run_index = 0; run_index < BENCH_RUNS; ++run_index) {
+            bench_phase run_phases[3];
+            bench_clock::time_point phase_start;
+            size_t phase_allocations;
 
-                current_position += str_target.length();
-            }
+            // --------------------------------------------------
+            // Parse Phase
+            // --------------------------------------------------
 
-            cout << endl << PROGRAM_LOGO << endl;
-            cout << HELP_MESSAGE;
+            // Every run starts from an empty store, so that it makes the same allocations
+            bench_tab_data = tab_store();
 
-            return 0;
-        }
-        // Handle configuration of --padding option
-        // Sets the number of spaces between table columns
-        else if (starts_with(option, "--padding")) {
-            size_t equal_sign_pos = option.find("=");
-            string option_key = option;
+            tab_parser bench_parser = make_parser(variant.col_separator, exclude_first_line);
 
-            if (equal_sign_pos != string::npos) {
-                option_key = option.substr(0, equal_sign_pos);
-                
-                try {
-                    int option_value = stoi(option.substr(equal_sign_pos + 1));
+            row_handler keep_row = [&](vector<string_view> &tab_row) {
+                store_row(bench_tab_data, tab_row, input.data(), input.data() + input.size());
+            };
 
-                    if (option_value < 0) {
-                        // Handle value less than 0
-                        cerr << "Error: The value of '" << option_key << "' cannot be less than 0" << endl << endl;
-                        cerr << "Type '-h' or '--help' to show the help message" << endl;
+            phase_allocations = allocation_count.load(memory_order_relaxed);
+            phase_start = bench_clock::now();
 
-                        return 1;  // Exit with error
-                    }
+            parse_block(bench_parser, input.data(), input.size(), keep_row);
+            parse_finish(bench_parser, keep_row);
 
-                    col_padding = option_value;
+            run_phases[0].seconds = chrono::duration<double>(bench_clock::now() - phase_start).count();
+            run_phases[0].allocations = allocation_count.load(memory_order_relaxed) - phase_allocations;
 
-                    continue;
-                }
-                catch (const invalid_argument &error_message) {
-                    // Handle invalid argument
-                    cerr << "Error: Invalid value for '" << option_key << "' option" << endl << endl;
-                    cerr << "Type '-h' or '--help' to show the help message" << endl;
+            // --------------------------------------------------
+            // Width Phase
+            // --------------------------------------------------
 
-                    return 1;  // Exit with error
-                }
-                catch (const out_of_range &error_message) {
-                    // Handle out of range value
-                    cerr << "Error: The value for the '" << option_key << "' option is out of range" << endl << endl;
-                    cerr << "Type '-h' or '--help' to show the help message" << endl;
+            tab_row_count = store_row_count(bench_tab_data);
+            const vector<size_t> &row_offsets = bench_tab_data.row_offsets;
 
-                    return 1;  // Exit with error
-                }
-            }
-            else {
-                // Handle missing '=' and value
-                cerr << "Error: The '" << option_key << "' option has no value assigned" << endl << endl;
-                cerr << "Type '-h' or '--help' to show the help message" << endl;
+            phase_allocations = allocation_count.load(memory_order_relaxed);
+            phase_start = bench_clock::now();
 
-                return 1;  // Exit with error
-            }
-        }
-        // Handle configuration of --separator option
-        // Sets the character used to separate columns
-        else if (starts_with(option, "--separator")) {
-            size_t equal_sign_pos = option.find("=");
-            string option_key = option;
-
-            if (equal_sign_pos != string::npos) {
-                option_key = option.substr(0, equal_sign_pos);
-
-                string option_value = option.substr(equal_sign_pos + 1);
-
-                // Map valid separator chars to ANSI separator constants
-                if (option_value == "newln") col_separator = NEWLINE;
-                else if (option_value == "space") col_separator = SPACE;
-                else if (option_value == "tab") col_separator = TAB;
-                else if (option_value == "wspace") col_separator = VOID;
-                else {
-                    // Handle invalid separator value
-                    cerr << "Error: Invalid '" << option_value << "' value in '" << option_key << "' option" << endl << endl;
-                    cerr << "Type '-h' or '--help' to show the help message" << endl;
-
-                    return 1;  // Exit with error
-                }
+            vector<size_t> tab_col_width;
 
-                continue;
+            for (size_t row_index = 0; row_index < tab_row_count; ++row_index) {
+                update_col_width(tab_col_width, &bench_tab_data.cell_widths[row_offsets[row_index]], row_offsets[row_index + 1] - row_offsets[row_index]);
             }
-            else {
-                // Handle missing '=' and value
-                cerr << "Error: The '" << option_key << "' option has no value assigned" << endl << endl;
-                cerr << "Type '-h' or '--help' to show the help message" << endl;
 
-                return 1;  // Exit with error
-            }
-        }
-        // Handle configuration of -h or --simplify options
-        // Disables the header row and skips the first line of input
-        else if (option == "-s" || option == "--simplify") {
-            headerless = true;
-            exclude_first_line = headerless;
+            render_plan plan = compile_render_plan(variant.render_options, tab_col_width, col_padding);
 
-            continue;
-        }
-        // Handle configuration of --tab-color, --btext-color, --htext-color, or --text-color options
-        // Sets the text color configuration for various parts of the table
-        else if (
-            starts_with(option, "--tab-color") || 
-            starts_with(option, "--btext-color") || 
-            starts_with(option, "--htext-color") || 
-            starts_with(option, "--text-color")
-        ) {
-            size_t equal_sign_pos = option.find("=");
-            string option_key = option;
-
-            if (equal_sign_pos != string::npos) {
-                option_key = option.substr(0, equal_sign_pos);
-
-                string temp_text_color;
-                string option_value = option.substr(equal_sign_pos + 1);
-
-                // Provides the text color constant to be use
-                string &target_var = (
-                    option_key == "--tab-color" ? table_color : 
-                    option_key == "--text-color" ? temp_text_color : 
-                    option_key == "--btext-color" ? body_text_color : 
-                    header_text_color
-                );
-
-                // Map received color strings to ANSI text color constants
-                if (option_value == "black") target_var = BLACK;
-                else if (option_value == "blue") target_var = BLUE;
-                else if (option_value == "cyan") target_var = CYAN;
-                else if (option_value == "green") target_var = GREEN;
-                else if (option_value == "magenta") target_var = MAGENTA;
-                else if (option_value == "red") target_var = RED;
-                else if (option_value == "white") target_var = WHITE;
-                else if (option_value == "yellow") target_var = YELLOW;
-                else {
-                    // Handle invalid value
-                    cerr << "Error: Invalid '" << option_value << "' value in '" << option_key << "' option" << endl << endl;
-                    cerr << "Type '-h' or '--help' to show the help message" << endl;
-
-                    return 1;  // Exit with error
-                }
+            run_phases[1].seconds = chrono::duration<double>(bench_clock::now() - phase_start).count();
+            run_phases[1].allocations = allocation_count.load(memory_order_relaxed) - phase_allocations;
 
-                // Apply same color to both header and body if --text-color is used
-                if (!temp_text_color.empty()) {
-                    header_text_color = temp_text_color;
-                    body_text_color = temp_text_color;
-                }
+            // --------------------------------------------------
+            // Render Phase
+            // --------------------------------------------------
 
-                continue;
-            }
-            else {
-                // Handle missing '=' and value
-                cerr << "Error: The '" << option_key << "' option has no value assigned" << endl << endl;
-                cerr << "Type '-h' or '--help' to show the help message" << endl;
+            // Rendered into memory, drained whenever a write(2) would have happened
+            out_buffer table_output = { -1, "", NULL };
+            output_bytes = 0;
 
-                return 1;  // Exit with error
-            }
-        }
-        // Handle configuration of --theme option
-        // Applies predefined formatting presets based on selected theme name
-        else if (starts_with(option, "--theme")) {
-            size_t equal_sign_pos = option.find("=");
-            string option_key = option;
-
-            if (equal_sign_pos != string::npos) {
-                option_key = option.substr(0, equal_sign_pos);
-
-                string option_value = option.substr(equal_sign_pos + 1);
-
-                if (option_value == "matrix") {
-                    header_text_align = ALIGN_CENTER;
-                    tab_border_style = heavy_border_style;
-                    table_color = GREEN;
-                    header_text_style = BOLD;
-                    header_text_color = GREEN;
-                    body_text_color = GREEN;
-                    body_text_style = BOLD;
-                }
-                else if (option_value == "mecha") {
-                    header_text_align = ALIGN_CENTER;
-                    body_text_align = ALIGN_CENTER;
-                    tab_border_style = double_border_style;
-                    header_text_style = BOLD;
-                    header_bg_color = BG_CYAN;
-                    body_bg_color = BG_MAGENTA;
-                    body_text_style = UNDERLINE;
-                }
-                else if (option_value == "myth") {
-                    header_text_align = ALIGN_CENTER;
-                    body_text_align = ALIGN_CENTER;
-                    tab_border_style = double_border_style;
-                    table_color = RED;
-                    header_bg_color = BG_RED;
-                    header_text_style = BOLD;
-                    header_text_color = WHITE;
-                    body_text_color = MAGENTA;
-                    body_bg_color = BG_BLACK;
-                }
-                else if (option_value == "retro") {
-                    header_text_align = ALIGN_CENTER;
-                    body_text_align = ALIGN_CENTER;
-                    tab_border_style = star_border_style;
-                    header_text_style = BOLD;
-                    header_bg_color = BG_RED;
-                    body_bg_color = BG_YELLOW;
-                    body_text_style = ITALIC;
-                }
-                else if (option_value == "sticky") {
-                    header_text_align = ALIGN_CENTER;
-                    col_separator = TAB;
-                    tab_border_style = double_border_style;
-                    header_text_style = BOLD;
-                    header_bg_color = BG_GREEN;
-                    body_bg_color = BG_YELLOW;
-                    body_text_style = UNDERLINE;
-                }
-                else {
-                    // Handle invalid value
-                    cerr << "Error: Invalid '" << option_value << "' value in '" << option_key << "' option" << endl << endl;
-                    cerr << "Type '-h' or '--help' to show the help message" << endl;
+            phase_allocations = allocation_count.load(memory_order_relaxed);
+            phase_start = bench_clock::now();
 
-                    return 1;  // Exit with error
-                }
+            for (size_t row_index = 0; row_index < tab_row_count; ++row_index) {
+                render_row(table_output, &bench_tab_data.cells[row_offsets[row_index]], &bench_tab_data.cell_widths[row_offsets[row_index]], row_offsets[row_index + 1] - row_offsets[row_index], row_index == 0, plan);
 
-                continue;
+                if (table_output.data.size() >= WRITE_BUFFER_SIZE) {
+                    output_bytes += table_output.data.size();
+                    table_output.data.clear();
+                }
             }
-            else {
-                // Handle missing '=' and value
-                cerr << "Error: The '" << option_key << "' option has no value assigned" << endl << endl;
-                cerr << "Type '-h' or '--help' to show the help message" << endl;
 
-                return 1;  // Exit with error
-            }
-        }
-        // Handle configuration of -v or --version options
-        // Prints the predefined version of the program
-        else if (option == "-v" || option == "--version") {
-            cout << PROGRAM_NAME << " " << PROGRAM_VERSION << endl;
+            render_bottom_border(table_output, plan);
 
-            return 0;
-        }
-        // Any unknown or invalid argument results in an error
-        else {
-            cerr << "Error: The '" << option << "' option is not available" << endl << endl;
-            cerr << "Type '-h' or '--help' to show the help message" << endl;
+            output_bytes += table_output.data.size();
+            table_output.data.clear();
 
-            return 1;  // Exit with error
+            run_phases[2].seconds = chrono::duration<double>(bench_clock::now() - phase_start).count();
+            run_phases[2].allocations = allocation_count.load(memory_order_relaxed) - phase_allocations;
+
+            bench_phase *best_phases[3] = { &parse_phase, &width_phase, &render_phase };
+
+            for (size_t phase_index = 0; phase_index < 3; ++phase_index) {
+                best_phases[phase_index]->seconds = min(best_phases[phase_index]->seconds, run_phases[phase_index].seconds);
+                best_phases[phase_index]->allocations = run_phases[phase_index].allocations;
+            }
         }
-    }
 
-    // Cleanup the memory
-    clear_tab_border(heavy_border_style);
-    clear_tab_border(double_border_style);
-    clear_tab_border(star_border_style);
+        // --------------------------------------------------
+        // Report
+        // --------------------------------------------------
+
+        struct rusage usage;
+
+        getrusage(RUSAGE_SELF, &usage);
+
+        report << "    {" << NEWLINE;
+        report << "      \"name\": \"" << variant.name << "\"," << NEWLINE;
+        report << "      \"separator\": \"" << get_separator_name(variant.col_separator) << "\"," << NEWLINE;
+        report << "      \"input_bytes\": " << input.size() << "," << NEWLINE;
+        report << "      \"output_bytes\": " << output_bytes << "," << NEWLINE;
+        report << "      \"table_rows\": " << tab_row_count << "," << NEWLINE;
+        report << "      \"table_cells\": " << bench_tab_data.cells.size() << "," << NEWLINE;
+        report << "      \"parse\": ";
+        write_bench_phase(report, parse_phase, input.size(), tab_row_count);
+        report << "," << NEWLINE << "      \"width\": ";
+        write_bench_phase(report, width_phase, input.size(), tab_row_count);
+        report << "," << NEWLINE << "      \"render\": ";
+        write_bench_phase(report, render_phase, output_bytes, tab_row_count);
+        report << "," << NEWLINE;
+        report << "      \"peak_rss_kb\": " << usage.ru_maxrss << NEWLINE;
+        report << "    }" << (variant_index + 1 < variants.size() ? "," : "") << NEWLINE;
+
+        throughputs.push_back({
+            variant.name,
+            { parse_phase.seconds, width_phase.seconds, render_phase.seconds },
+            { input.size() / max(parse_phase.seconds, 1e-9) / 1e6, input.size() / max(width_phase.seconds, 1e-9) / 1e6, output_bytes / max(render_phase.seconds, 1e-9) / 1e6 }
+        });
+
+        store_clear(bench_tab_data);
+    }
 
-    PROGRAM_LOGO.clear();
-    HELP_MESSAGE.clear();
+    report << "  ]" << NEWLINE;
+    report << "}" << NEWLINE;
 
-    // --------------------------------------------------
-    // Variable Initialization
-    // --------------------------------------------------
+    cout << report.str();
 
-    int cmdout_char;                         // Stores the current character read from stdin
+    size_t sizes[3] = { row_count, col_count, cell_length };
 
-    queue<char> cmdout_char_queue;           // Queue to accumulate characters of a single token (cell)
-    vector<string> temp_row_data;            // Temporarily stores a row of parsed tokens (strings)
-    vector<vector<string>> cmdout_tab_data;  // 2D vector to store all parsed table rows
-    vector<size_t> tab_col_width;            // Holds the maximum width of each column for alignment
+    if (!baseline_path.empty()) return check_bench_baseline(baseline_path, tolerance, sizes, throughputs);
 
-    size_t max_col_count = 0;                // Tracks the maximum number of columns across all rows
+    // Exit successfully
+    return 0;
+}
 
-    // --------------------------------------------------
-    // Standard Input Parsing Loop
-    // --------------------------------------------------
+// --------------------------------------------------
+// Statistics
+// --------------------------------------------------
 
-    // Reads characters from stdin and splits them into tokens and rows
-    while ((cmdout_char = getchar()) != EOF) {
-        // If current character is considered whitespace (based on separator rules)
-        if (is_wspace(cmdout_char, col_separator)) {
-            // Convert queued characters into a string token
-            if (!cmdout_char_queue.empty()) {
-                ostringstream cmdout_oss;
-
-                while (!cmdout_char_queue.empty()) {
-                    cmdout_oss << cmdout_char_queue.front();
-                    cmdout_char_queue.pop();
-                }
+/**
+ * @brief Writes the --stats report as a JSON object.
+ *
+ * @param stats_fd     Descriptor receiving the report (stderr or the --stats file), or -1 when --stats is not set.
+ * @param stats        The run statistics.
+ * @param exit_status  The exit status of the run.
+ *
+ * @return The exit status of the run, or 1 if the report could not be written.
+ */
+int write_stats(
+    const int &stats_fd,
+    const tab_stats &stats,
+    const int &exit_status
+) {
+    if (stats_fd < 0) return exit_status;
 
-                string cmdout_token = cmdout_oss.str();
-                
-                // Push token into row data unless excluded as a header
-                if (!cmdout_token.empty() && (!first_line || !exclude_first_line)) temp_row_data.push_back(cmdout_token);
-            }
+    ostringstream report;
+    struct rusage usage;
 
-            // If newline, treat as end of row
-            if (cmdout_char == NEWLINE) {
-                // Skip the first line if headerless mode is on
-                if (first_line && exclude_first_line) {
-                    first_line = false;
+    double total_wall_seconds = 0;
+    double total_cpu_seconds = 0;
 
-                    continue;
-                }
+    getrusage(RUSAGE_SELF, &usage);
 
-                // Push completed row into table data
-                if (!temp_row_data.empty()) {
-                    cmdout_tab_data.push_back(temp_row_data);
-                    temp_row_data.clear();
-                }
-            }
+    report << fixed << setprecision(6);
+    report << "{" << NEWLINE;
+    report << "  \"program\": \"" << PROGRAM_NAME << "\"," << NEWLINE;
+    report << "  \"version\": \"" << PROGRAM_VERSION << "\"," << NEWLINE;
+    report << "  \"phases\": {" << NEWLINE;
 
-            continue;
-        }
+    for (size_t phase = 0; phase < PHASE_COUNT; ++phase) {
+        report << "    \"" << STATS_PHASE_NAMES[phase] << "\": { \"wall_seconds\": " << stats.wall_seconds[phase]
+               << ", \"cpu_seconds\": " << stats.cpu_seconds[phase] << " }," << NEWLINE;
 
-        // If not whitespace, queue the character for token building
-        cmdout_char_queue.push(static_cast<char>(cmdout_char));
+        total_wall_seconds += stats.wall_seconds[phase];
+        total_cpu_seconds += stats.cpu_seconds[phase];
     }
 
-    // --------------------------------------------------
-    // Final Token and Row Flush (after EOF)
-    // --------------------------------------------------
-
-    // Ensure any remaining characters are captured as the last token
-    first_line = true;
+    report << "    \"total\": { \"wall_seconds\": " << total_wall_seconds << ", \"cpu_seconds\": " << total_cpu_seconds << " }" << NEWLINE;
+    report << "  }," << NEWLINE;
+    report << "  \"input_bytes\": " << input_byte_count.load(memory_order_relaxed) << "," << NEWLINE;
+    report << "  \"output_bytes\": " << output_byte_count.load(memory_order_relaxed) << "," << NEWLINE;
+    report << "  \"rows\": " << stats.row_count << "," << NEWLINE;
+    report << "  \"cells\": " << stats.cell_count << "," << NEWLINE;
+    report << "  \"max_columns\": " << stats.max_col_count << "," << NEWLINE;
+    report << "  \"peak_rss_kb\": " << usage.ru_maxrss << "," << NEWLINE;
+    report << "  \"allocations\": " << allocation_count.load(memory_order_relaxed) << NEWLINE;
+    report << "}" << NEWLINE;
 
-    if (!cmdout_char_queue.empty()) {
-        ostringstream cmdout_oss;
+    string report_text = report.str();
+    bool written = write_block(stats_fd, report_text.data(), report_text.size());
 
-        while (!cmdout_char_queue.empty()) {
-            cmdout_oss << cmdout_char_queue.front();
-            cmdout_char_queue.pop();
-        }
+    if (stats_fd != STDERR_FILENO) written = close(stats_fd) == 0 && written;
 
-        string cmdout_token = cmdout_oss.str();
+    if (!written) {
+        cerr << "Error: Unable to write the '--stats' report: " << strerror(errno) << endl;
 
-        if (!cmdout_token.empty()) temp_row_data.push_back(cmdout_token);
+        return 1;  // Exit with error
     }
 
-    // Push last row if not empty
-    if (!temp_row_data.empty()) cmdout_tab_data.push_back(temp_row_data);
+    return exit_status;
+}
 
-    // --------------------------------------------------
-    // Determine Maximum Column Count
-    // --------------------------------------------------
+// --------------------------------------------------
+// Help Text
+// --------------------------------------------------
 
-    // Sets the header data
-    if (!usrinput_header_data.empty() && !exclude_first_line) {
-        cmdout_tab_data[0] = usrinput_header_data;
+// Program logo shown above the help message
+static constexpr char PROGRAM_LOGO[] = "\t\t _____     _   _____ _   _   _ _ \n"
+                                        "\t\t|_   _|___| |_|   __| |_|_| |_| |\n"
+                                        "\t\t  | | | .'| . |__   |  _| | | | |\n"
+                                        "\t\t  |_| |__,|___|_____|_| |_|_| |_|\n"
+                                        "\t\t                          |___|  \n";
+
+// Command-line usage and help guide, [program] is replaced with the program name
+static constexpr char HELP_MESSAGE[] =
+    "Usage: [program] [...OPTIONS]\n"
+    "       [program] --watch[=SECONDS] [...OPTIONS] -- COMMAND\n\n"
+    "OPTIONS\n"
+    "      --bbg-color=COLOR       Set body background color\n"
+    "                              Available background colors:\n"
+    "                                - black     - blue\n"
+    "                                - cyan      - green\n"
+    "                                - magenta   - red\n"
+    "                                - white     - yellow\n"
+    "                              Example:\n"
+    "                                --bbg-color=green  # sets the body background color to green\n"
+    "      --bg-color=COLOR        Set header and body background color\n"
+    "                              Available background colors:\n"
+    "                                - black     - blue\n"
+    "                                - cyan      - green\n"
+    "                                - magenta   - red\n"
+    "                                - white     - yellow\n"
+    "                              Example:\n"
+    "                                --text-color=cyan  # sets the background color to cyan\n"
+    "      --bench[=SIZES]         Benchmark the parse, width and render phases on a generated table\n"
+    "                              and print the results as JSON, for the current options, every\n"
+    "                              theme and every border style (single thread, input ignored,\n"
+    "                              fastest of 3 runs), along with the startup latency of the program\n"
+    "                              SIZES is ROWS,COLUMNS,CELL_LENGTH (default 100000,8,12)\n"
+    "                              Example:\n"
+    "                                --bench=1000000,4,6 --separator=tab\n"
+    "      --bench-baseline=REPORT[,PERCENT]\n"
+    "                              Run --bench, then fail if the throughput of a phase dropped more\n"
+    "                              than PERCENT (default 10) below the saved --bench REPORT\n"
+    "                              Example:\n"
+    "                                --bench-baseline=base.json,5  # fails on a 5% slowdown against 'tabstijl --bench > base.json'\n"
+    "-b or --borderless            Hide table border\n"
+    "      --border-style=STYLE    Set border style\n"
+    "                              Available border styles:\n"
+    "                                - double  # Double line border style\n"
+    "                                - heavy   # Heavy line border style\n"
+    "                                - star\n"
+    "                              Example:\n"
+    "                                --border-style=heavy  # sets the border style to heavy line\n"
+    "      --btext-align=ALIGN     Set body text alignment\n"
+    "                              Available alignments:\n"
+    "                                - left\n"
+    "                                - center\n"
+    "                                - right\n"
+    "                              Example:\n"
+    "                                --btext-align=left  # sets the body text alignment to left\n"
+    "      --btext-color=COLOR     Set body text color\n"
+    "                              Available text colors:\n"
+    "                                - black     - blue\n"
+    "                                - cyan      - green\n"
+    "                                - magenta   - red\n"
+    "                                - white     - yellow\n"
+    "                              Example:\n"
+    "                                --btext-color=red  # sets the body text color to red\n"
+    "      --btext-style=STYLE     Set body text style\n"
+    "                              Available text styles:\n"
+    "                                - bold      - inverse\n"
+    "                                - italic    - strike\n"
+    "                                - underline\n"
+    "                              Example:\n"
+    "                                --btext-style=bold  # sets the body text style to bold\n"
+    "      --client[=SOCKET]       Send the other options and the input to a '--serve' daemon and\n"
+    "                              write its table, or render locally when no daemon of the user\n"
+    "                              is running on a socket only the user can access\n"
+    "                              (must be the first option)\n"
+    "                              Example:\n"
+    "                                --client --theme=matrix  # renders through the default daemon\n"
+    "      --col-width=WIDTHS      Set fixed column content widths for live rendering (implies --live)\n"
+    "                              Example:\n"
+    "                                --col-width=10,4,30  # each width separated by a comma\n"
+    "      --columns=COLUMNS       Show only the given columns, in the given order, by number (from 1)\n"
+    "                              or by --hdata name, the other columns are never stored\n"
+    "                              Example:\n"
+    "                                --columns=1,3,9  # shows the permissions, owner and file name of 'ls -l'\n"
+    "      --fit[=LAYOUT]          Fit a table wider than the terminal (or --max-table-width)\n"
+    "                              Available layouts:\n"
+    "                                - auto      # chosen from the column widths (default)\n"
+    "                                - shrink    # narrows the widest columns, truncating their cells\n"
+    "                                - wrap      # narrows the widest columns, wrapping their cells\n"
+    "                                - stack     # splits the columns into sections, one below the other\n"
+    "                              Example:\n"
+    "                                --fit=wrap  # keeps every character of long cells on screen\n"
+    "      --footer=AGGREGATES     Add a row per aggregate of the numeric columns below the table\n"
+    "                              (integers, decimals, sizes such as 4.0K and percentages)\n"
+    "                              Available aggregates:\n"
+    "                                - sum       - avg\n"
+    "                                - min       - max\n"
+    "                              Example:\n"
+    "                                --footer=sum,max  # sums up the sizes of 'du -sh *'\n"
+    "      --format=FORMAT         Set the format of the table written to stdout\n"
+    "                              Available formats:\n"
+    "                                - pretty    - tsv\n"
+    "                                - csv       - json\n"
+    "                                - markdown\n"
+    "                              Example:\n"
+    "                                --format=json  # one object per row, keyed by the header\n"
+    "-f or --fusion                Hide the separator between header and body\n"
+    "      --hbg-color=COLOR       Set header background color\n"
+    "                              Available background colors:\n"
+    "                                - black     - blue\n"
+    "                                - cyan      - green\n"
+    "                                - magenta   - red\n"
+    "                                - white     - yellow\n"
+    "                              Example:\n"
+    "                                --hbg-color=green  # sets the header background color to green\n"
+    "      --hdata                 Set header data (columns name)\n"
+    "                              Example:\n"
+    "                                --hdata=permission,username,group,size,filename  # each column name separated by a comma\n"
+    "      --head=ROWS             Show only the first ROWS body rows, the input is not read further\n"
+    "                              Example:\n"
+    "                                --head=50 --tail=50  # shows the first and the last 50 rows\n"
+    "-h or --help                  Show help message\n"
+    "      --htext-align=ALIGN     Set header text alignment\n"
+    "                              Available alignments:\n"
+    "                                - left\n"
+    "                                - center\n"
+    "                                - right\n"
+    "                              Example:\n"
+    "                                --htext-align=center  # sets the header text alignment to center\n"
+    "      --htext-color=COLOR     Set header text color\n"
+    "                              Available text colors:\n"
+    "                                - black     - blue\n"
+    "                                - cyan      - green\n"
+    "                                - magenta   - red\n"
+    "                                - white     - yellow\n"
+    "                              Example:\n"
+    "                                --htext-color=red  # sets the header text color to red\n"
+    "      --htext-style=STYLE     Set header text style\n"
+    "                              Available text styles:\n"
+    "                                - bold      - inverse\n"
+    "                                - italic    - strike\n"
+    "                                - underline\n"
+    "                              Example:\n"
+    "                                --htext-style=bold  # sets the header text style to bold\n"
+    "      --input=PATH            Read the table from a file instead of stdin, gzip and zstd files\n"
+    "                              being decompressed on the fly (on a second thread with --jobs)\n"
+    "                              Example:\n"
+    "                                --input=access.log.gz  # no 'zcat |' needed\n"
+    "      --jobs=VALUE            Set the number of threads used to parse and render\n"
+    "                              (ignored with --live and --stream)\n"
+    "                              Example:\n"
+    "                                --jobs=8  # uses 8 threads, 0 uses every available core\n"
+    "      --live[=ROWS]           Render rows as soon as they arrive (e.g. 'tail -f')\n"
+    "                              Column widths are fixed from the first ROWS rows (default 20)\n"
+    "                              or once the input pauses, longer cells are truncated\n"
+    "                              Example:\n"
+    "                                --live=5  # fixes the column widths from the first 5 rows\n"
+    "      --max-col-width=VALUE   Truncate cells wider than VALUE columns with an ellipsis\n"
+    "                              Example:\n"
+    "                                --max-col-width=40  # keeps long cells from widening their column\n"
+    "      --max-table-width=VALUE Narrow the widest columns until the table fits in VALUE columns,\n"
+    "                              truncating their cells with an ellipsis (\"auto\" for the terminal width)\n"
+    "                              Example:\n"
+    "                                --max-table-width=auto  # fits the table in the terminal\n"
+    "      --numeric               Right-align the columns holding only numbers, sizes (e.g. 4.0K)\n"
+    "                              or percentages\n"
+    "      --padding=VALUE         Set column padding\n"
+    "                              Example:\n"
+    "                                --padding=8  # padding 8 spaces to left\n"
+    "      --page=ROWS             Write the table as pages of ROWS body rows, each with its own\n"
+    "                              column widths and the header, holding only one page in memory\n"
+    "                              Example:\n"
+    "                                --page=100  # writes a new table every 100 rows\n"
+    "      --separator             Set column separator\n"
+    "                              Available separators:\n"
+    "                                - newln   # Newline\n"
+    "                                - space\n"
+    "                                - tab\n"
+    "                                - wspace  # every whitespace\n"
+    "                              Example:\n"
+    "                                --separator=wspace  # sets the separator to whitespace\n"
+    "      --serve[=SOCKET]        Run a daemon rendering the tables of '--client' runs, listening on\n"
+    "                              SOCKET (default $XDG_RUNTIME_DIR/tabstijl.sock, or\n"
+    "                              /tmp/tabstijl-UID.sock), the parsed options of recent runs\n"
+    "                              are cached so that repeated runs skip option parsing\n"
+    "                              Example:\n"
+    "                                --serve &  # starts the default daemon in the background\n"
+    "-s or --simplify              Show table in simple form (without header)\n"
+    "      --stream                Render in two passes, keeping only column widths in memory\n"
+    "                              (for inputs too large to buffer)\n"
+    "      --sort=COLUMN[:num|:lex][:desc]\n"
+    "                              Sort the body rows by a shown COLUMN (number or --hdata name),\n"
+    "                              as text (default) or by number, sizes (e.g. 4.0K) and percentages\n"
+    "                              comparing by value and other cells by leading number, the header\n"
+    "                              stays first\n"
+    "                              (--head and --tail then keep the first and last sorted rows)\n"
+    "                              Example:\n"
+    "                                --sort=5:num:desc --head=10  # shows the 10 largest files of 'ls -l'\n"
+    "      --stats[=FILE]          Report phase timings, CPU time, bytes, rows, cells, peak RSS and\n"
+    "                              allocations as JSON to stderr, or to FILE\n"
+    "                              (with --jobs and --stream the width pass is timed as parse,\n"
+    "                              with --live every row is timed as render)\n"
+    "                              Example:\n"
+    "                                --stats=run.json  # writes the report to run.json\n"
+    "      --tab-color=COLOR       Set table border color\n"
+    "                              Available table border colors:\n"
+    "                                - black     - blue\n"
+    "                                - cyan      - green\n"
+    "                                - magenta   - red\n"
+    "                                - white     - yellow\n"
+    "                              Example:\n"
+    "                                --tab-color=yellow  # sets the border color to yellow\n"
+    "      --tail=ROWS             Show only the last ROWS body rows, held in a ring buffer\n"
+    "                              Example:\n"
+    "                                --tail=20  # shows the last 20 rows\n"
+    "      --tee=FILE:FORMAT       Also write the table to FILE in the given format\n"
+    "                              (not available with --live and --stream)\n"
+    "                              Example:\n"
+    "                                --tee=table.csv:csv  # shows the pretty table and saves a CSV copy\n"
+    "      --text-align=ALIGN      Set header and body text alignment\n"
+    "                              Available alignments:\n"
+    "                                - left\n"
+    "                                - center\n"
+    "                                - right\n"
+    "                              Example:\n"
+    "                                --text-align=right  # sets the text alignment to right\n"
+    "      --text-color=COLOR      Set header and body text color\n"
+    "                              Available text colors:\n"
+    "                                - black     - blue\n"
+    "                                - cyan      - green\n"
+    "                                - magenta   - red\n"
+    "                                - white     - yellow\n"
+    "                              Example:\n"
+    "                                --text-color=red  # sets the text color to red\n"
+    "      --text-style=STYLE      Set header and body text style\n"
+    "                              Available text styles:\n"
+    "                                - bold      - inverse\n"
+    "                                - italic    - strike\n"
+    "                                - underline\n"
+    "                              Example:\n"
+    "                                --text-style=underline  # sets the text style to underline\n"
+    "      --theme=THEME           Set table theme\n"
+    "                              Available themes:\n"
+    "                                - matrix    - mecha\n"
+    "                                - myth      - retro\n"
+    "                                - sticky\n"
+    "                              Example:\n"
+    "                                --theme=matrix  # sets the theme to matrix\n"
+    "-v or --version               Show [program] version\n"
+    "      --watch[=SECONDS] -- COMMAND\n"
+    "                              Run COMMAND with 'sh -c' every SECONDS (default 2) and keep its\n"
+    "                              table on the screen, redrawing only the cells that changed\n"
+    "                              (the whole table when a column width or the row count changes;\n"
+    "                              not available with --live, --stream, --page, --format, --tee\n"
+    "                              and --input)\n"
+    "                              Example:\n"
+    "                                --watch=1 --sort=3:num:desc --head=10 -- ps aux\n"
+    "      --where=COLUMN~TEXT     Show only the rows whose COLUMN (number or --hdata name) contains TEXT,\n"
+    "                              the header row is always shown\n"
+    "                              Example:\n"
+    "                                --where=1~root  # keeps the 'ps aux' rows of root\n\n"
+    "See the GitHub page at <https://github.com/naufalhanif25/tabstijl.git>\n";
 
-        // Cleanup the memory
-        usrinput_header_data.clear();
-    }
+// --------------------------------------------------
+// Option Parsing
+// --------------------------------------------------
 
-    // Finds the row with the most columns to standardize layout
-    for (const auto &tab_row : cmdout_tab_data) max_col_count = max(max_col_count, tab_row.size());
+// Parsed command-line configuration struct
+typedef struct tab_config {
+    tab_render_options render_options;    // Styling and border configuration consumed by the render plan
+    char col_separator;                   // A character used to separate the header and body rows of the table
+    int col_padding;                      // Number of spaces added on each side of a table cell value
+    bool exclude_first_line;              // Whether to skip the first input line during processing
+    bool use_stream;                      // Render in two passes over a spill file instead of buffering rows
+    bool use_live;                        // Render rows as they arrive using fixed column widths
+    bool use_bench;                       // Benchmark a synthetic table instead of rendering the input
+    size_t live_sample_rows;              // Rows sampled to fix the column widths in live mode
+    size_t jobs;                          // Number of threads used to parse and render
+    size_t bench_row_count;               // Number of lines generated by --bench
+    size_t bench_col_count;               // Number of cells per line generated by --bench
+    size_t bench_cell_length;             // Number of characters per cell generated by --bench
+    string bench_baseline_path;           // Report of an earlier --bench run to compare to, or empty
+    double bench_tolerance;               // Percent of throughput a phase may lose against the baseline
+    vector<string> usrinput_header_data;  // Holds the header data from user input
+    vector<size_t> usrinput_col_width;    // Holds the column width hints from user input
+    string usrinput_input_path;           // Holds the input file path from user input
+    output_format format;                 // Format of the table written to stdout
+    string tee_path;                      // File receiving a second copy of the table, or empty
+    output_format tee_format;             // Format of the table written to the tee file
+    bool use_stats;                       // Flag to report the run statistics
+    string stats_path;                    // File receiving the run statistics, or empty for stderr
+    size_t max_col_width;                 // Widest content of a column, 0 for no limit
+    size_t max_table_width;               // Widest rendered table, 0 for no limit
+    bool fit_terminal;                    // Flag to limit the table width to the terminal width
+    fit_layout fit;                       // Layout of a table wider than the terminal, FIT_NONE without --fit
+    vector<string> usrinput_columns;      // Columns selected with --columns, by number or --hdata name
+    vector<size_t> selected_cols;         // Input column of each shown column (0-based), empty to show every column
+    string usrinput_where_col;            // Column tested by --where, by number or --hdata name, empty for no filter
+    string where_text;                    // Substring the --where column must contain
+    size_t where_col;                     // Input column tested by --where (0-based), SIZE_MAX for no filter
+    size_t head_rows;                     // Number of first body rows shown, 0 for no limit
+    size_t tail_rows;                     // Number of last body rows shown, 0 for no limit
+    size_t page_rows;                     // Number of body rows per page, 0 for a single page
+    string usrinput_sort_col;             // Column sorted by with --sort, by number or --hdata name
+    sort_spec sort;                       // Sort settings, sort_col being SIZE_MAX for no sort
+    bool use_serve;                       // Flag to run the --serve daemon instead of rendering
+    string serve_path;                    // Socket of the --serve daemon, or empty for the default socket
+    double watch_interval;                // Seconds between the runs of the --watch command, 0 for no --watch
+    vector<string> watch_command;         // Command after '--', run by --watch
+    bool use_numeric;                     // Flag to right-align the numeric columns
+    vector<footer_aggregate> footer;      // Aggregates of the --footer rows, empty for no footer
+} tab_config;
+
+/**
+ * @brief Builds the configuration holding the default of every option.
+ *
+ * @return The default configuration.
+ */
+tab_config default_config() {
+    return {
+        default_render_options(),  // render_options
+        SPACE,              // col_separator
+        2,                  // col_padding
+        false,              // exclude_first_line
+        false,              // use_stream
+        false,              // use_live
+        false,              // use_bench
+        LIVE_SAMPLE_ROWS,   // live_sample_rows
+        1,                  // jobs
+        BENCH_ROWS,         // bench_row_count
+        BENCH_COLS,         // bench_col_count
+        BENCH_CELL_LENGTH,  // bench_cell_length
+        "",                 // bench_baseline_path
+        BENCH_TOLERANCE,    // bench_tolerance
+        {}, {}, "",         // usrinput_header_data, usrinput_col_width, usrinput_input_path
+        FORMAT_PRETTY,      // format
+        "",                 // tee_path
+        FORMAT_PRETTY,      // tee_format
+        false,              // use_stats
+        "",                 // stats_path
+        0,                  // max_col_width
+        0,                  // max_table_width
+        false,              // fit_terminal
+        FIT_NONE,           // fit
+        {}, {},             // usrinput_columns, selected_cols
+        "", "",             // usrinput_where_col, where_text
+        SIZE_MAX,           // where_col
+        0, 0, 0,            // head_rows, tail_rows, page_rows
+        "",                 // usrinput_sort_col
+        { SIZE_MAX, SORT_LEX, false },  // sort
+        false,              // use_serve
+        "",                 // serve_path
+        0,                  // watch_interval
+        {},                 // watch_command
+        false,              // use_numeric
+        {}                  // footer
+    };
+}
 
-    // Resize column width vector based on max column count
-    tab_col_width.resize(max_col_count, 0);
+// Outcome of one option handler
+typedef enum option_status {
+    OPTION_OK,     // The option was applied
+    OPTION_ERROR,  // The option is invalid, an error was printed
+    OPTION_EXIT    // The option printed its output, the program exits successfully
+} option_status;
+
+// Kinds of value an option accepts
+typedef enum option_arity {
+    OPTION_FLAG,            // No value (-b, --stream)
+    OPTION_OPTIONAL_VALUE,  // An optional value after '=' (--live[=ROWS])
+    OPTION_REQUIRED_VALUE   // A value after '=' (--padding=VALUE)
+} option_arity;
+
+// Named value accepted by an option
+typedef struct named_value {
+    const char *name;   // The value given on the command line
+    const char *value;  // The ANSI sequence or alignment it maps to
+} named_value;
+
+// Text colors accepted by the text and border color options
+static constexpr named_value TEXT_COLORS[] = {
+    { "black", BLACK }, { "blue", BLUE }, { "cyan", CYAN }, { "green", GREEN },
+    { "magenta", MAGENTA }, { "red", RED }, { "white", WHITE }, { "yellow", YELLOW }
+};
+
+// Background colors accepted by the background color options
+static constexpr named_value BG_COLORS[] = {
+    { "black", BG_BLACK }, { "blue", BG_BLUE }, { "cyan", BG_CYAN }, { "green", BG_GREEN },
+    { "magenta", BG_MAGENTA }, { "red", BG_RED }, { "white", BG_WHITE }, { "yellow", BG_YELLOW }
+};
+
+// Text styles accepted by the text style options
+static constexpr named_value TEXT_STYLES[] = {
+    { "bold", BOLD }, { "inverse", INVERSE }, { "italic", ITALIC }, { "strike", STRIKETHROUGH }, { "underline", UNDERLINE }
+};
+
+// Alignments accepted by the text alignment options
+static constexpr named_value TEXT_ALIGNMENTS[] = {
+    { ALIGN_LEFT, ALIGN_LEFT }, { ALIGN_CENTER, ALIGN_CENTER }, { ALIGN_RIGHT, ALIGN_RIGHT }
+};
+
+// Named column separator struct
+typedef struct separator_entry {
+    const char *name;    // Value of the --separator option
+    char col_separator;  // The column delimiter
+} separator_entry;
+
+// Separators accepted by --separator
+static constexpr separator_entry SEPARATORS[] = {
+    { "newln", NEWLINE }, { "space", SPACE }, { "tab", TAB }, { "wspace", VOID }
+};
+
+struct option_entry;
+
+// Option handler, applying the value of an option to the configuration
+typedef option_status (*option_handler)(tab_config &config, const option_entry &option, const string_view &option_value, const bool &has_value);
+
+// Command-line option struct
+typedef struct option_entry {
+    string_view name;                            // Option name, including the leading dashes
+    option_arity arity;                          // Whether the option takes a value
+    option_handler handler;                      // Applies the option to the configuration
+    const named_value *values;                   // Values accepted by a named value option, or NULL
+    size_t value_count;                          // Number of accepted values
+    string tab_render_options::*target;          // Setting receiving a named value, or NULL
+    string tab_render_options::*second_target;   // Second setting receiving the same value, or NULL
+} option_entry;
 
-    // --------------------------------------------------
-    // Compute Column Widths for Alignment
-    // --------------------------------------------------
+/**
+ * @brief Prints an option error followed by the help hint.
+ *
+ * @param error_message  The error, without the "Error: " prefix.
+ *
+ * @return `OPTION_ERROR`, so handlers can return the call directly.
+ */
+option_status option_error(const string &error_message) {
+    cerr << "Error: " << error_message << endl << endl;
+    cerr << "Type '-h' or '--help' to show the help message" << endl;
+
+    return OPTION_ERROR;
+}
+
+/**
+ * @brief Prints the error for a value an option does not accept.
+ *
+ * @param option        The option.
+ * @param option_value  The rejected value.
+ *
+ * @return `OPTION_ERROR`.
+ */
+option_status invalid_value_error(
+    const option_entry &option,
+    const string_view &option_value
+) {
+    return option_error("Invalid '" + string(option_value) + "' value in '" + string(option.name) + "' option");
+}
 
-    // Iterates through all cells to calculate the maximum width needed per column
-    for (const auto &tab_row : cmdout_tab_data) {
-        for (size_t index = 0; index < tab_row.size(); ++index) tab_col_width[index] = max(tab_col_width[index], tab_row[index].length());
+/**
+ * @brief Parses the integer value of an option.
+ *
+ * @param option        The option, named in the error messages.
+ * @param option_value  The value to parse.
+ * @param min_value     The smallest accepted value.
+ * @param result        Receives the parsed value.
+ *
+ * @return `OPTION_OK`, or `OPTION_ERROR` if the value is not an integer of at least `min_value`.
+ */
+option_status parse_int_value(
+    const option_entry &option,
+    const string_view &option_value,
+    const int &min_value,
+    int &result
+) {
+    try {
+        result = stoi(string(option_value));
+    }
+    catch (const invalid_argument &error_message) {
+        // Handle invalid argument
+        return option_error("Invalid value for '" + string(option.name) + "' option");
+    }
+    catch (const out_of_range &error_message) {
+        // Handle out of range value
+        return option_error("The value for the '" + string(option.name) + "' option is out of range");
     }
 
-    // Add padding to each column width for spacing
-    for (auto& col_width : tab_col_width) col_width += col_padding;
+    // Handle value less than the minimum
+    if (result < min_value) return option_error("The value of '" + string(option.name) + "' cannot be less than " + to_string(min_value));
 
-    // --------------------------------------------------
-    // Render Output Table
-    // --------------------------------------------------
+    return OPTION_OK;
+}
 
-    for (const auto &tab_row : cmdout_tab_data) {
-        // Render top border if it's the first line and table borders are enabled
-        if (first_line && use_border) cout << get_tab_border(
-            max_col_count, 
-            tab_col_width, 
-            tab_border_style.top.left_char_unicode, 
-            tab_border_style.top.mid_char_unicode, 
-            tab_border_style.top.right_char_unicode, 
-            tab_border_style.top.fill_char_unicode,
-            table_color
-        );
+/**
+ * @brief Parses the comma separated integer values of an option.
+ *
+ * @param option        The option, named in the error messages.
+ * @param option_value  The values to parse.
+ * @param min_value     The smallest accepted value.
+ * @param result        Receives the parsed values, appended in order.
+ *
+ * @return `OPTION_OK`, or `OPTION_ERROR` if a value is not an integer of at least `min_value`.
+ */
+option_status parse_int_list_value(
+    const option_entry &option,
+    const string_view &option_value,
+    const int &min_value,
+    vector<size_t> &result
+) {
+    string option_value_token;
+    stringstream option_value_ss (static_cast<string>(option_value));
 
-        // Print left vertical border if borders are enabled
-        if (use_border) cout << table_color << tab_border_style.vertical_line << DEFAULT;
-
-        // Print each cell in the current row
-        for (size_t index = 0; index < max_col_count; ++index) {
-            // Get content for current cell or empty string if missing
-            string tab_cell = (index < tab_row.size()) ? tab_row[index] : "";
-            
-            // Get text alignment data for header or body
-            pair<size_t, string> tab_col_data = align_text(
-                tab_cell, 
-                tab_col_width[index], 
-                (first_line && !headerless ? header_text_align : !first_line || headerless ? body_text_align : ALIGN_LEFT)
-            );
-
-            // Apply styles depending on whether it's a header or body row
-            cout << (first_line && !headerless ? header_text_style + header_bg_color + header_text_color : "\0") 
-                 << (!first_line || headerless ? body_text_style + body_bg_color + body_text_color : "\0") 
-                 << setw(tab_col_data.first) << left << tab_col_data.second << DEFAULT << table_color 
-                 << (use_border ? tab_border_style.vertical_line : "\0");
+    // Map received comma separated values
+    while (getline(option_value_ss, option_value_token, ',')) {
+        int list_value;
+
+        try {
+            list_value = stoi(option_value_token);
+        }
+        catch (const exception &error_message) {
+            // Handle invalid or out of range value
+            return invalid_value_error(option, option_value);
         }
 
-        // End of row
-        cout << endl;
-
-        // Render header-body separator after the first line if enabled
-        if (first_line && !headerless && use_border && use_separator) cout << get_tab_border(
-            max_col_count, 
-            tab_col_width, 
-            tab_border_style.separator.left_char_unicode, 
-            tab_border_style.separator.mid_char_unicode, 
-            tab_border_style.separator.right_char_unicode, 
-            tab_border_style.separator.fill_char_unicode,
-            table_color
-        );
+        // Handle value less than the minimum
+        if (list_value < min_value) return option_error("The value of '" + string(option.name) + "' cannot be less than " + to_string(min_value));
 
-        // Mark first line as processed
-        first_line = false;
+        result.push_back(list_value);
     }
 
-    // Cleanup the memory
-    if (!header_text_color.empty()) header_text_color;
-    if (!body_text_color.empty()) body_text_color;
-    if (!header_bg_color.empty()) header_bg_color;
-    if (!body_bg_color.empty()) body_bg_color;
-    if (!header_text_style.empty()) header_text_style;
-    if (!body_text_style.empty()) body_text_style;
-    if (!header_text_align.empty()) header_text_align;
-    if (!body_text_align.empty()) body_text_align;
-
-    cmdout_tab_data.clear();
-
-    // Render bottom border of the table if enabled
-    if (use_border) cout << get_tab_border(
-        max_col_count, 
-        tab_col_width, 
-        tab_border_style.bottom.left_char_unicode, 
-        tab_border_style.bottom.mid_char_unicode, 
-        tab_border_style.bottom.right_char_unicode, 
-        tab_border_style.bottom.fill_char_unicode,
-        table_color
-    );
+    return OPTION_OK;
+}
+
+// Handles the color, style and alignment options, which map a named value to one or two settings
+option_status handle_named_value(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    for (size_t index = 0; index < option.value_count; ++index) {
+        if (option_value != option.values[index].name) continue;
+
+        config.render_options.*option.target = option.values[index].value;
+
+        if (option.second_target != NULL) config.render_options.*option.second_target = option.values[index].value;
+
+        return OPTION_OK;
+    }
+
+    return invalid_value_error(option, option_value);
+}
+
+// Handles --bench, optionally setting the rows, columns and cell length of the generated table
+option_status handle_bench(tab_config &config, const option_entry &option, const string_view &option_value, const bool &has_value) {
+    config.use_bench = true;
+
+    if (!has_value) return OPTION_OK;
+
+    vector<size_t> bench_sizes;
+
+    if (parse_int_list_value(option, option_value, 1, bench_sizes) != OPTION_OK) return OPTION_ERROR;
+
+    // Handle missing or extra sizes
+    if (bench_sizes.size() != 3) return invalid_value_error(option, option_value);
+
+    config.bench_row_count = bench_sizes[0];
+    config.bench_col_count = bench_sizes[1];
+    config.bench_cell_length = bench_sizes[2];
+
+    return OPTION_OK;
+}
+
+// Handles --bench-baseline, failing the benchmark when a phase got slower than in a saved report
+option_status handle_bench_baseline(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    config.use_bench = true;
+    config.bench_baseline_path = option_value;
+
+    size_t comma_index = option_value.rfind(',');
+
+    // A trailing number after the last comma is the tolerance
+    if (comma_index != string_view::npos) {
+        int option_number;
+
+        if (parse_int_value(option, option_value.substr(comma_index + 1), 0, option_number) != OPTION_OK) return OPTION_ERROR;
+
+        config.bench_baseline_path = option_value.substr(0, comma_index);
+        config.bench_tolerance = option_number;
+    }
+
+    if (config.bench_baseline_path.empty()) return invalid_value_error(option, option_value);
+
+    return OPTION_OK;
+}
+
+// Handles -b and --borderless, disabling table borders entirely
+option_status handle_borderless(tab_config &config, const option_entry &, const string_view &, const bool &) {
+    config.render_options.use_border = false;
+
+    return OPTION_OK;
+}
+
+// Handles --border-style, setting the border characters
+option_status handle_border_style(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    const tab_border *border_style = find_border_style(option_value);
+
+    if (border_style == NULL) return invalid_value_error(option, option_value);
+
+    config.render_options.border_style = *border_style;
+
+    return OPTION_OK;
+}
+
+// Handles --client, which is only accepted as the first option
+option_status handle_client(tab_config &, const option_entry &, const string_view &, const bool &) {
+    return option_error("The '--client' option must be the first option");
+}
+
+// Handles --col-width, setting fixed column widths for live rendering
+option_status handle_col_width(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    if (parse_int_list_value(option, option_value, 0, config.usrinput_col_width) != OPTION_OK) return OPTION_ERROR;
+
+    // Handle empty value
+    if (config.usrinput_col_width.empty()) return invalid_value_error(option, option_value);
+
+    config.use_live = true;
+
+    return OPTION_OK;
+}
+
+/**
+ * @brief Finds an output format by its --format name.
+ *
+ * @param format_name  The format: "pretty", "tsv", "csv", "json", or "markdown".
+ * @param format       Receives the output format.
+ *
+ * @return `false` if no format has the given name, `true` otherwise.
+ */
+bool find_output_format(
+    const string_view &format_name,
+    output_format &format
+) {
+    for (const auto &format_entry : OUTPUT_FORMATS) {
+        if (format_name != format_entry.name) continue;
+
+        format = format_entry.format;
+
+        return true;
+    }
+
+    return false;
+}
+
+// Handles --footer, adding one row per aggregate of the numeric columns
+option_status handle_footer(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    string option_value_token;
+    stringstream option_value_ss (static_cast<string>(option_value));
+
+    config.footer.clear();
+
+    // Map received comma separated aggregates
+    while (getline(option_value_ss, option_value_token, ',')) {
+        const footer_entry *aggregate_entry = NULL;
+
+        for (const auto &entry : FOOTER_AGGREGATES) {
+            if (option_value_token == entry.name) aggregate_entry = &entry;
+        }
+
+        if (aggregate_entry == NULL) return invalid_value_error(option, option_value);
+
+        config.footer.push_back(aggregate_entry->aggregate);
+    }
+
+    if (config.footer.empty()) return invalid_value_error(option, option_value);
+
+    return OPTION_OK;
+}
+
+// Handles --fit, fitting a wide table into the terminal with the given layout
+option_status handle_fit(tab_config &config, const option_entry &option, const string_view &option_value, const bool &has_value) {
+    config.fit = FIT_AUTO;
+
+    if (!has_value) return OPTION_OK;
+
+    for (const auto &entry : FIT_LAYOUTS) {
+        if (option_value != entry.name) continue;
+
+        config.fit = entry.layout;
+
+        return OPTION_OK;
+    }
+
+    return invalid_value_error(option, option_value);
+}
+
+// Handles --format, setting the format of the table written to stdout
+option_status handle_format(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    if (!find_output_format(option_value, config.format)) return invalid_value_error(option, option_value);
+
+    return OPTION_OK;
+}
+
+// Handles --columns, selecting the shown columns by number or --hdata name
+option_status handle_columns(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    string option_value_token;
+    stringstream option_value_ss (static_cast<string>(option_value));
+
+    config.usrinput_columns.clear();
+
+    // Map received comma separated columns
+    while (getline(option_value_ss, option_value_token, ',')) {
+        if (option_value_token.empty()) return invalid_value_error(option, option_value);
+
+        config.usrinput_columns.push_back(option_value_token);
+    }
+
+    if (config.usrinput_columns.empty()) return invalid_value_error(option, option_value);
+
+    return OPTION_OK;
+}
+
+// Handles -f and --fusion, hiding the separator between header and body
+option_status handle_fusion(tab_config &config, const option_entry &, const string_view &, const bool &) {
+    config.render_options.use_separator = false;
+
+    return OPTION_OK;
+}
+
+// Handles --hdata, setting the header data
+option_status handle_hdata(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    // Handle empty value
+    if (option_value.empty()) return invalid_value_error(option, option_value);
+
+    string option_value_token;
+    stringstream option_value_ss (static_cast<string>(option_value));
+
+    // Map received header data strings
+    while (getline(option_value_ss, option_value_token, ',')) config.usrinput_header_data.push_back(option_value_token);
+
+    return OPTION_OK;
+}
+
+// Handles --head, showing only the first body rows, then ending the input early
+option_status handle_head(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    int option_number;
+
+    if (parse_int_value(option, option_value, 1, option_number) != OPTION_OK) return OPTION_ERROR;
+
+    config.head_rows = option_number;
+
+    return OPTION_OK;
+}
+
+// Handles -h and --help, printing the help message with the program name injected in placeholder
+option_status handle_help(tab_config &, const option_entry &, const string_view &, const bool &) {
+    size_t current_position = 0;
+
+    string help_message = HELP_MESSAGE;
+    string str_to_replace = "[program]";
+    string str_target = PROGRAM_NAME;
+
+    while ((current_position = help_message.find(str_to_replace, current_position)) != string::npos) {
+        help_message.replace(current_position, str_to_replace.length(), str_target);
+
+        current_position += str_target.length();
+    }
+
+    cout << endl << PROGRAM_LOGO << endl;
+    cout << help_message;
+
+    return OPTION_EXIT;
+}
+
+// Handles --input, reading the table from a file instead of stdin
+option_status handle_input(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    // Handle empty value
+    if (option_value.empty()) return invalid_value_error(option, option_value);
+
+    config.usrinput_input_path = option_value;
+
+    return OPTION_OK;
+}
+
+// Handles --jobs, setting the number of threads used to parse and render
+option_status handle_jobs(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    int option_number;
+
+    if (parse_int_value(option, option_value, 0, option_number) != OPTION_OK) return OPTION_ERROR;
+
+    // Use every available core for 0
+    config.jobs = option_number == 0 ? max(1U, thread::hardware_concurrency()) : option_number;
+
+    return OPTION_OK;
+}
+
+// Handles --live, rendering rows as they arrive and optionally setting the number of sampled rows
+option_status handle_live(tab_config &config, const option_entry &option, const string_view &option_value, const bool &has_value) {
+    config.use_live = true;
+
+    if (!has_value) return OPTION_OK;
+
+    int option_number;
+
+    if (parse_int_value(option, option_value, 0, option_number) != OPTION_OK) return OPTION_ERROR;
+
+    config.live_sample_rows = option_number;
+
+    return OPTION_OK;
+}
+
+// Handles --max-col-width, setting the widest content of a column
+option_status handle_max_col_width(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    int option_number;
+
+    if (parse_int_value(option, option_value, 1, option_number) != OPTION_OK) return OPTION_ERROR;
+
+    config.max_col_width = option_number;
+
+    return OPTION_OK;
+}
+
+// Handles --max-table-width, setting the widest rendered table, "auto" for the terminal width
+option_status handle_max_table_width(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    config.fit_terminal = option_value == "auto";
+
+    if (config.fit_terminal) return OPTION_OK;
+
+    int option_number;
+
+    if (parse_int_value(option, option_value, 1, option_number) != OPTION_OK) return OPTION_ERROR;
+
+    config.max_table_width = option_number;
+
+    return OPTION_OK;
+}
+
+// Handles --numeric, right-aligning the columns holding only numbers
+option_status handle_numeric(tab_config &config, const option_entry &, const string_view &, const bool &) {
+    config.use_numeric = true;
+
+    return OPTION_OK;
+}
+
+// Handles --padding, setting the number of spaces between table columns
+option_status handle_padding(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    return parse_int_value(option, option_value, 0, config.col_padding);
+}
+
+// Handles --page, writing the table as pages with their own column widths
+option_status handle_page(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    int option_number;
+
+    if (parse_int_value(option, option_value, 1, option_number) != OPTION_OK) return OPTION_ERROR;
+
+    config.page_rows = option_number;
+
+    return OPTION_OK;
+}
+
+// Handles --separator, setting the character used to separate columns
+option_status handle_separator(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    for (const auto &separator : SEPARATORS) {
+        if (option_value != separator.name) continue;
+
+        config.col_separator = separator.col_separator;
+
+        return OPTION_OK;
+    }
+
+    return invalid_value_error(option, option_value);
+}
+
+// Handles --serve, running a daemon that renders the tables of '--client' runs
+option_status handle_serve(tab_config &config, const option_entry &option, const string_view &option_value, const bool &has_value) {
+    if (has_value && option_value.empty()) return invalid_value_error(option, option_value);
+
+    config.use_serve = true;
+    config.serve_path = option_value;
+
+    return OPTION_OK;
+}
+
+// Handles -s and --simplify, disabling the header row and skipping the first line of input
+option_status handle_simplify(tab_config &config, const option_entry &, const string_view &, const bool &) {
+    config.render_options.headerless = true;
+    config.exclude_first_line = true;
+
+    return OPTION_OK;
+}
+
+// Handles --stream, rendering in two passes with memory bounded by the column count
+option_status handle_stream(tab_config &config, const option_entry &, const string_view &, const bool &) {
+    config.use_stream = true;
+
+    return OPTION_OK;
+}
+
+// Handles --sort, sorting the body rows by a column given as COL[:num|:lex][:desc]
+option_status handle_sort(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    string option_value_token;
+    stringstream option_value_ss (static_cast<string>(option_value));
+
+    config.usrinput_sort_col.clear();
+    config.sort.kind = SORT_LEX;
+    config.sort.descending = false;
+
+    // The column, then the modifiers
+    if (!getline(option_value_ss, config.usrinput_sort_col, ':') || config.usrinput_sort_col.empty()) return invalid_value_error(option, option_value);
+
+    while (getline(option_value_ss, option_value_token, ':')) {
+        if (option_value_token == "num") config.sort.kind = SORT_NUM;
+        else if (option_value_token == "lex") config.sort.kind = SORT_LEX;
+        else if (option_value_token == "desc") config.sort.descending = true;
+        else return invalid_value_error(option, option_value);
+    }
+
+    return OPTION_OK;
+}
+
+// Handles --stats, reporting the run statistics to stderr or to the given file
+option_status handle_stats(tab_config &config, const option_entry &option, const string_view &option_value, const bool &has_value) {
+    if (has_value && option_value.empty()) return invalid_value_error(option, option_value);
+
+    config.use_stats = true;
+    config.stats_path = option_value;
+
+    return OPTION_OK;
+}
+
+// Handles --tail, showing only the last body rows
+option_status handle_tail(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    int option_number;
+
+    if (parse_int_value(option, option_value, 1, option_number) != OPTION_OK) return OPTION_ERROR;
+
+    config.tail_rows = option_number;
+
+    return OPTION_OK;
+}
+
+// Handles --tee, writing a second copy of the table in another format to a file
+option_status handle_tee(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    size_t colon_pos = option_value.rfind(':');
+
+    // Handle a missing file or an invalid format
+    if (colon_pos == string_view::npos || colon_pos == 0 || !find_output_format(option_value.substr(colon_pos + 1), config.tee_format)) {
+        return invalid_value_error(option, option_value);
+    }
+
+    config.tee_path = option_value.substr(0, colon_pos);
+
+    return OPTION_OK;
+}
+
+// Handles --theme, applying predefined formatting presets based on selected theme name
+option_status handle_theme(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    if (!apply_theme(option_value, config.render_options, config.col_separator)) return invalid_value_error(option, option_value);
+
+    return OPTION_OK;
+}
+
+// Handles --watch, running the command after '--' periodically
+option_status handle_watch(tab_config &config, const option_entry &option, const string_view &option_value, const bool &has_value) {
+    config.watch_interval = WATCH_INTERVAL;
+
+    if (!has_value) return OPTION_OK;
+
+    string interval_text (option_value);
+    char *interval_end;
+
+    errno = 0;
+    config.watch_interval = strtod(interval_text.c_str(), &interval_end);
+
+    // Handle a non-numeric, non-positive or endless interval
+    if (interval_text.empty() || *interval_end != VOID || errno != 0 || !(config.watch_interval > 0) || !isfinite(config.watch_interval)) {
+        return invalid_value_error(option, option_value);
+    }
+
+    return OPTION_OK;
+}
+
+// Handles --where, keeping only the rows whose column contains a substring
+option_status handle_where(tab_config &config, const option_entry &option, const string_view &option_value, const bool &) {
+    size_t tilde_pos = option_value.find('~');
+
+    // Handle a missing column or operator
+    if (tilde_pos == string_view::npos || tilde_pos == 0) return invalid_value_error(option, option_value);
+
+    config.usrinput_where_col = option_value.substr(0, tilde_pos);
+    config.where_text = option_value.substr(tilde_pos + 1);
+
+    return OPTION_OK;
+}
+
+// Handles -v and --version, printing the predefined version of the program
+option_status handle_version(tab_config &, const option_entry &, const string_view &, const bool &) {
+    cout << PROGRAM_NAME << " " << PROGRAM_VERSION << endl;
+
+    return OPTION_EXIT;
+}
+
+// Shorthand for the members of the options table
+#define NAMED_VALUES(table) table, sizeof(table) / sizeof(table[0])
+#define NO_VALUES NULL, 0, NULL, NULL
+
+// Every command-line option, sorted by name for binary search
+static constexpr option_entry OPTIONS[] = {
+    { "--bbg-color", OPTION_REQUIRED_VALUE, handle_named_value, NAMED_VALUES(BG_COLORS), &tab_render_options::body_bg_color, NULL },
+    { "--bench", OPTION_OPTIONAL_VALUE, handle_bench, NO_VALUES },
+    { "--bench-baseline", OPTION_REQUIRED_VALUE, handle_bench_baseline, NO_VALUES },
+    { "--bg-color", OPTION_REQUIRED_VALUE, handle_named_value, NAMED_VALUES(BG_COLORS), &tab_render_options::header_bg_color, &tab_render_options::body_bg_color },
+    { "--border-style", OPTION_REQUIRED_VALUE, handle_border_style, NO_VALUES },
+    { "--borderless", OPTION_FLAG, handle_borderless, NO_VALUES },
+    { "--btext-align", OPTION_REQUIRED_VALUE, handle_named_value, NAMED_VALUES(TEXT_ALIGNMENTS), &tab_render_options::body_text_align, NULL },
+    { "--btext-color", OPTION_REQUIRED_VALUE, handle_named_value, NAMED_VALUES(TEXT_COLORS), &tab_render_options::body_text_color, NULL },
+    { "--btext-style", OPTION_REQUIRED_VALUE, handle_named_value, NAMED_VALUES(TEXT_STYLES), &tab_render_options::body_text_style, NULL },
+    { "--client", OPTION_OPTIONAL_VALUE, handle_client, NO_VALUES },
+    { "--col-width", OPTION_REQUIRED_VALUE, handle_col_width, NO_VALUES },
+    { "--columns", OPTION_REQUIRED_VALUE, handle_columns, NO_VALUES },
+    { "--fit", OPTION_OPTIONAL_VALUE, handle_fit, NO_VALUES },
+    { "--footer", OPTION_REQUIRED_VALUE, handle_footer, NO_VALUES },
+    { "--format", OPTION_REQUIRED_VALUE, handle_format, NO_VALUES },
+    { "--fusion", OPTION_FLAG, handle_fusion, NO_VALUES },
+    { "--hbg-color", OPTION_REQUIRED_VALUE, handle_named_value, NAMED_VALUES(BG_COLORS), &tab_render_options::header_bg_color, NULL },
+    { "--hdata", OPTION_REQUIRED_VALUE, handle_hdata, NO_VALUES },
+    { "--head", OPTION_REQUIRED_VALUE, handle_head, NO_VALUES },
+    { "--help", OPTION_FLAG, handle_help, NO_VALUES },
+    { "--htext-align", OPTION_REQUIRED_VALUE, handle_named_value, NAMED_VALUES(TEXT_ALIGNMENTS), &tab_render_options::header_text_align, NULL },
+    { "--htext-color", OPTION_REQUIRED_VALUE, handle_named_value, NAMED_VALUES(TEXT_COLORS), &tab_render_options::header_text_color, NULL },
+    { "--htext-style", OPTION_REQUIRED_VALUE, handle_named_value, NAMED_VALUES(TEXT_STYLES), &tab_render_options::header_text_style, NULL },
+    { "--input", OPTION_REQUIRED_VALUE, handle_input, NO_VALUES },
+    { "--jobs", OPTION_REQUIRED_VALUE, handle_jobs, NO_VALUES },
+    { "--live", OPTION_OPTIONAL_VALUE, handle_live, NO_VALUES },
+    { "--max-col-width", OPTION_REQUIRED_VALUE, handle_max_col_width, NO_VALUES },
+    { "--max-table-width", OPTION_REQUIRED_VALUE, handle_max_table_width, NO_VALUES },
+    { "--numeric", OPTION_FLAG, handle_numeric, NO_VALUES },
+    { "--padding", OPTION_REQUIRED_VALUE, handle_padding, NO_VALUES },
+    { "--page", OPTION_REQUIRED_VALUE, handle_page, NO_VALUES },
+    { "--separator", OPTION_REQUIRED_VALUE, handle_separator, NO_VALUES },
+    { "--serve", OPTION_OPTIONAL_VALUE, handle_serve, NO_VALUES },
+    { "--simplify", OPTION_FLAG, handle_simplify, NO_VALUES },
+    { "--sort", OPTION_REQUIRED_VALUE, handle_sort, NO_VALUES },
+    { "--stats", OPTION_OPTIONAL_VALUE, handle_stats, NO_VALUES },
+    { "--stream", OPTION_FLAG, handle_stream, NO_VALUES },
+    { "--tab-color", OPTION_REQUIRED_VALUE, handle_named_value, NAMED_VALUES(TEXT_COLORS), &tab_render_options::table_color, NULL },
+    { "--tail", OPTION_REQUIRED_VALUE, handle_tail, NO_VALUES },
+    { "--tee", OPTION_REQUIRED_VALUE, handle_tee, NO_VALUES },
+    { "--text-align", OPTION_REQUIRED_VALUE, handle_named_value, NAMED_VALUES(TEXT_ALIGNMENTS), &tab_render_options::header_text_align, &tab_render_options::body_text_align },
+    { "--text-color", OPTION_REQUIRED_VALUE, handle_named_value, NAMED_VALUES(TEXT_COLORS), &tab_render_options::header_text_color, &tab_render_options::body_text_color },
+    { "--text-style", OPTION_REQUIRED_VALUE, handle_named_value, NAMED_VALUES(TEXT_STYLES), &tab_render_options::header_text_style, &tab_render_options::body_text_style },
+    { "--theme", OPTION_REQUIRED_VALUE, handle_theme, NO_VALUES },
+    { "--version", OPTION_FLAG, handle_version, NO_VALUES },
+    { "--watch", OPTION_OPTIONAL_VALUE, handle_watch, NO_VALUES },
+    { "--where", OPTION_REQUIRED_VALUE, handle_where, NO_VALUES },
+    { "-b", OPTION_FLAG, handle_borderless, NO_VALUES },
+    { "-f", OPTION_FLAG, handle_fusion, NO_VALUES },
+    { "-h", OPTION_FLAG, handle_help, NO_VALUES },
+    { "-s", OPTION_FLAG, handle_simplify, NO_VALUES },
+    { "-v", OPTION_FLAG, handle_version, NO_VALUES }
+};
+
+#undef NAMED_VALUES
+#undef NO_VALUES
+
+/**
+ * @brief Checks at compile time that the options table is sorted by name.
+ *
+ * @return `true` if every option name is smaller than the next one.
+ */
+constexpr bool options_sorted() {
+    for (size_t index = 1; index < sizeof(OPTIONS) / sizeof(OPTIONS[0]); ++index) {
+        if (!(OPTIONS[index - 1].name < OPTIONS[index].name)) return false;
+    }
+
+    return true;
+}
+
+static_assert(options_sorted(), "OPTIONS must be sorted by name");
+
+/**
+ * @brief Resolves a column given by its number (from 1) or by its --hdata name.
+ *
+ * @param col_name     The column number or name.
+ * @param header_data  The header data from --hdata.
+ * @param col_index    Receives the input column (0-based).
+ *
+ * @return `false` if the column is neither a positive number nor a --hdata name.
+ */
+bool resolve_column(
+    const string &col_name,
+    const vector<string> &header_data,
+    size_t &col_index
+) {
+    if (all_of(col_name.begin(), col_name.end(), [](const char &character) { return isdigit(static_cast<unsigned char>(character)); })) {
+        errno = 0;
+        col_index = strtoull(col_name.c_str(), NULL, 10);
+
+        if (errno != 0 || col_index == 0) return false;
+
+        --col_index;
+
+        return true;
+    }
+
+    auto header_cell = find(header_data.begin(), header_data.end(), col_name);
+
+    if (header_cell == header_data.end()) return false;
+
+    col_index = header_cell - header_data.begin();
+
+    return true;
+}
+
+/**
+ * @brief Resolves the --columns, --where and --sort columns and narrows the --hdata header to the shown columns.
+ *
+ * Run once every option is parsed, as the columns may be named by a later --hdata.
+ *
+ * @param config  The configuration.
+ *
+ * @return `OPTION_OK`, or `OPTION_ERROR` if a column cannot be resolved.
+ */
+option_status resolve_columns(tab_config &config) {
+    for (const auto &col_name : config.usrinput_columns) {
+        size_t col_index;
+
+        if (!resolve_column(col_name, config.usrinput_header_data, col_index)) return option_error("Unknown column '" + col_name + "' in '--columns' option");
+
+        config.selected_cols.push_back(col_index);
+    }
+
+    if (!config.usrinput_where_col.empty() && !resolve_column(config.usrinput_where_col, config.usrinput_header_data, config.where_col)) {
+        return option_error("Unknown column '" + config.usrinput_where_col + "' in '--where' option");
+    }
+
+    // The header names the shown columns only
+    if (!config.selected_cols.empty() && !config.usrinput_header_data.empty()) {
+        vector<string> header_data;
+
+        for (const auto &col_index : config.selected_cols) header_data.push_back(col_index < config.usrinput_header_data.size() ? config.usrinput_header_data[col_index] : "");
+
+        config.usrinput_header_data = header_data;
+    }
+
+    // The sorted column is a column of the shown table
+    if (!config.usrinput_sort_col.empty() && !resolve_column(config.usrinput_sort_col, config.usrinput_header_data, config.sort.sort_col)) {
+        return option_error("Unknown column '" + config.usrinput_sort_col + "' in '--sort' option");
+    }
+
+    return OPTION_OK;
+}
+
+/**
+ * @brief Parses the command-line arguments into the configuration.
+ *
+ * Each argument is split at its first '=' into a name and a value, and the name is
+ * looked up in the sorted `OPTIONS` table with a binary search. The handler of the
+ * option then parses the value. Arguments are applied in order, so later options
+ * override earlier ones. The arguments after `--` are the command run by --watch.
+ *
+ * @param argc         Number of command-line arguments.
+ * @param argv         The command-line arguments.
+ * @param config       The configuration, holding the defaults on entry.
+ * @param exit_status  Receives the process exit status when parsing stops the program.
+ *
+ * @return `true` if the program should go on, `false` if it should exit with `exit_status`.
+ */
+bool parse_options(
+    int argc,
+    char *argv[],
+    tab_config &config,
+    int &exit_status
+) {
+    const option_entry *options_end = OPTIONS + sizeof(OPTIONS) / sizeof(OPTIONS[0]);
+
+    // Loop through all command-line arguments
+    for (int index = 1; index < argc; index++) {
+        const string_view option = argv[index];
+
+        // The rest of the arguments is the --watch command
+        if (option == "--") {
+            config.watch_command.assign(argv + index + 1, argv + argc);
+
+            break;
+        }
+
+        size_t equal_sign_pos = option.find('=');
+        bool has_value = equal_sign_pos != string_view::npos;
+
+        string_view option_key = option.substr(0, equal_sign_pos);
+        string_view option_value = has_value ? option.substr(equal_sign_pos + 1) : string_view();
+
+        const option_entry *found = lower_bound(OPTIONS, options_end, option_key, [](const option_entry &entry, const string_view &key) {
+            return entry.name < key;
+        });
+
+        option_status status;
+
+        // Any unknown or invalid argument results in an error
+        if (found == options_end || found->name != option_key || (has_value && found->arity == OPTION_FLAG)) {
+            status = option_error("The '" + string(option) + "' option is not available");
+        }
+        // Handle missing '=' and value
+        else if (!has_value && found->arity == OPTION_REQUIRED_VALUE) {
+            status = option_error("The '" + string(option_key) + "' option has no value assigned");
+        }
+        else status = found->handler(config, *found, option_value, has_value);
+
+        if (status != OPTION_OK) {
+            exit_status = status == OPTION_EXIT ? 0 : 1;
+
+            return false;
+        }
+    }
+
+    // The command after '--' belongs to --watch
+    option_status status = OPTION_OK;
+
+    if (config.watch_interval > 0 && config.watch_command.empty()) status = option_error("The '--watch' option has no command after '--'");
+    else if (config.watch_interval == 0 && !config.watch_command.empty()) status = option_error("A command after '--' is only run with the '--watch' option");
+
+    if (status != OPTION_OK || resolve_columns(config) != OPTION_OK) {
+        exit_status = 1;
+
+        return false;
+    }
+
+    return true;
+}
+
+// --------------------------------------------------
+// Watch
+// --------------------------------------------------
+
+// Table shown on the screen by --watch
+typedef struct watch_frame {
+    vector<char> input;        // Output of the command, holding the cells
+    tab_store store;           // The rows of the table
+    vector<size_t> col_width;  // Content width of each column
+    size_t line_count;         // Number of terminal lines taken by the table, 0 before the first frame
+} watch_frame;
+
+/**
+ * @brief Gets the number of lines of the terminal on stdout.
+ *
+ * @return The number of lines, or 0 if stdout is not a terminal.
+ */
+size_t get_terminal_height() {
+    winsize terminal_size;
+
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &terminal_size) == 0 && terminal_size.ws_row > 0) return terminal_size.ws_row;
+
+    return 0;
+}
+
+/**
+ * @brief Runs a shell command and collects its output.
+ *
+ * The stdout and stderr of the command both go into the output, as they would on a terminal.
+ *
+ * @param command_line  The command, run with `sh -c`.
+ * @param output        Receives the output of the command.
+ *
+ * @return `false` if the command cannot be started.
+ */
+bool run_watch_command(
+    const string &command_line,
+    vector<char> &output
+) {
+    int pipe_fds[2];
+
+    if (pipe2(pipe_fds, O_CLOEXEC) != 0) return false;
+
+    posix_spawn_file_actions_t file_actions;
+
+    posix_spawn_file_actions_init(&file_actions);
+    posix_spawn_file_actions_adddup2(&file_actions, pipe_fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&file_actions, pipe_fds[1], STDERR_FILENO);
+
+    char shell_name[] = "sh";
+    char shell_flag[] = "-c";
+    char *spawn_argv[] = { shell_name, shell_flag, const_cast<char *>(command_line.c_str()), NULL };
+
+    pid_t child_pid;
+    bool is_spawned = posix_spawn(&child_pid, "/bin/sh", &file_actions, NULL, spawn_argv, environ) == 0;
+
+    posix_spawn_file_actions_destroy(&file_actions);
+    close(pipe_fds[1]);
+
+    if (is_spawned) read_all(pipe_fds[0], output);
+
+    close(pipe_fds[0]);
+
+    while (is_spawned && waitpid(child_pid, NULL, 0) < 0 && errno == EINTR);
+
+    return is_spawned;
+}
+
+/**
+ * @brief Runs the --watch command once and lays out its output as the next frame.
+ *
+ * The output goes through the same tokenizer, --hdata, --sort, --head and --tail handling
+ * as a table read from stdin. The cells are views into the output kept by the frame.
+ *
+ * @param command_line     The command, run with `sh -c`.
+ * @param parser_template  The tokenizer settings, copied for every run.
+ * @param config           The configuration.
+ * @param frame            Receives the frame.
+ *
+ * @return `false` if the command cannot be started.
+ */
+bool load_watch_frame(
+    const string &command_line,
+    const tab_parser &parser_template,
+    const tab_config &config,
+    watch_frame &frame
+) {
+    if (!run_watch_command(command_line, frame.input)) return false;
+
+    tab_store &store = frame.store;
+    tab_parser parser = parser_template;
+
+    const char *input_begin = frame.input.data();
+    const char *input_end = input_begin + frame.input.size();
+
+    row_handler keep_row = [&](vector<string_view> &tab_row) {
+        store_row(store, tab_row, input_begin, input_end);
+    };
+
+    store_clear(store);
+
+    parse_block(parser, input_begin, frame.input.size(), keep_row);
+    parse_finish(parser, keep_row);
+
+    // Sets the header data
+    if (!config.usrinput_header_data.empty() && !config.exclude_first_line && store_row_count(store) > 0) store_replace_row(store, 0, config.usrinput_header_data);
+
+    size_t row_count = store_row_count(store);
+    size_t header_row_count = min<size_t>(config.render_options.headerless ? 0 : 1, row_count);
+
+    if (config.sort.sort_col != SIZE_MAX) sort_table(store, config.sort, header_row_count, config.head_rows, config.tail_rows, 1);
+    else if (config.head_rows > 0 || config.tail_rows > 0) {
+        // The header, then the first --head and the last --tail body rows
+        size_t body_row_count = row_count - header_row_count;
+        size_t kept_head = min(config.head_rows, body_row_count);
+        size_t kept_tail = min(config.tail_rows, body_row_count - kept_head);
+
+        vector<size_t> row_order;
+
+        for (size_t row_index = 0; row_index < header_row_count + kept_head; ++row_index) row_order.push_back(row_index);
+
+        for (size_t row_index = row_count - kept_tail; row_index < row_count; ++row_index) row_order.push_back(row_index);
+
+        store_reorder_rows(store, row_order);
+    }
+
+    // Measure the content width of each column
+    const vector<size_t> &row_offsets = store.row_offsets;
+    size_t max_col_count = 0;
+
+    row_count = store_row_count(store);
+
+    for (size_t row_index = 0; row_index < row_count; ++row_index) max_col_count = max(max_col_count, row_offsets[row_index + 1] - row_offsets[row_index]);
+
+    frame.col_width.assign(max_col_count, 0);
+
+    for (size_t row_index = 0; row_index < row_count; ++row_index) update_col_width(frame.col_width, &store.cell_widths[row_offsets[row_index]], row_offsets[row_index + 1] - row_offsets[row_index]);
+
+    clamp_col_widths(frame.col_width, config.max_col_width, config.max_table_width, config.col_padding, config.render_options.use_border);
+
+    return true;
+}
+
+/**
+ * @brief Writes the cells of a frame that differ from the frame on the screen.
+ *
+ * Both frames have the same column widths and rows, so every cell keeps its place. Each
+ * changed cell is written over the old one after an absolute cursor move, and the cursor
+ * is then left below the table.
+ *
+ * @param screen_output  The writer of stdout.
+ * @param shown_frame    The frame on the screen.
+ * @param frame          The new frame.
+ * @param plan           The render plan of both frames.
+ */
+void patch_watch_frame(
+    out_buffer &screen_output,
+    const watch_frame &shown_frame,
+    const watch_frame &frame,
+    const render_plan &plan
+) {
+    const tab_render_options &render_options = *plan.options;
+    const tab_store &shown_store = shown_frame.store;
+    const tab_store &store = frame.store;
+
+    size_t row_count = store_row_count(store);
+    size_t border_width = render_options.use_border ? 1 : 0;
+    bool has_separator_line = !render_options.headerless && render_options.use_border && render_options.use_separator;
+
+    for (size_t row_index = 0; row_index < row_count; ++row_index) {
+        size_t cell_begin = store.row_offsets[row_index];
+        size_t cell_count = store.row_offsets[row_index + 1] - cell_begin;
+        size_t shown_cell_begin = shown_store.row_offsets[row_index];
+        size_t shown_cell_count = shown_store.row_offsets[row_index + 1] - shown_cell_begin;
+
+        // Lines of the top border and of the header-body separator come before the row
+        size_t line_index = border_width + row_index + (has_separator_line && row_index > 0 ? 1 : 0);
+        size_t col_offset = border_width;
+
+        for (size_t index = 0; index < plan.max_col_count; ++index) {
+            string_view tab_cell = index < cell_count ? store.cells[cell_begin + index] : "";
+            string_view shown_cell = index < shown_cell_count ? shown_store.cells[shown_cell_begin + index] : "";
+
+            if (tab_cell != shown_cell) {
+                out_write(screen_output, "\e[" + to_string(line_index + 1) + ";" + to_string(col_offset + 1) + "H");
+                render_cell(screen_output, tab_cell, index < cell_count ? store.cell_widths[cell_begin + index] : 0, index, row_index == 0 && !render_options.headerless, plan);
+                out_write(screen_output, DEFAULT);
+            }
+
+            col_offset += plan.col_width[index] + border_width;
+        }
+    }
+
+    out_write(screen_output, "\e[" + to_string(shown_frame.line_count + 1) + ";1H");
+}
+
+/**
+ * @brief Runs the --watch command every interval and keeps its table on the screen.
+ *
+ * The first frame, and every frame whose column widths, row count or terminal size
+ * differ from the frame on the screen, clears the screen and is written whole. Other
+ * frames only write the cells that changed, so the output is proportional to the number
+ * of changed cells. A frame taller than the terminal is always written whole, as the
+ * lines scrolled out cannot be reached by the cursor.
+ *
+ * @param parser_template  The tokenizer settings, copied for every run.
+ * @param config           The configuration.
+ *
+ * @return The process exit status, 1 if the command cannot be started.
+ */
+int watch_table(
+    const tab_parser &parser_template,
+    tab_config config
+) {
+    string command_line;
+
+    for (const auto &argument : config.watch_command) command_line += (command_line.empty() ? "" : " ") + argument;
+
+    watch_frame frames[2] = {};
+    size_t shown_index = 0;          // Index of the frame on the screen
+    size_t terminal_height = 0;      // Lines of the terminal when the frame on the screen was written
+    size_t terminal_width = 0;       // Columns of the terminal when the frame on the screen was written
+
+    string frame_text;               // The whole frame, rendered in memory
+    out_buffer screen_output = { STDOUT_FILENO, "", NULL };
+
+    chrono::steady_clock::duration interval = chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(config.watch_interval));
+    chrono::steady_clock::time_point next_run = chrono::steady_clock::now();
+
+    while (true) {
+        const watch_frame &shown_frame = frames[shown_index];
+        watch_frame &frame = frames[1 - shown_index];
+
+        size_t current_height = get_terminal_height();
+        size_t current_width = get_terminal_width();
+
+        if (config.fit_terminal) config.max_table_width = current_width;
+
+        if (!load_watch_frame(command_line, parser_template, config, frame)) {
+            cerr << "Error: Unable to run the '--watch' command" << endl;
+
+            return 1;  // Exit with error
+        }
+
+        // Render the whole frame in memory, it is only written when the screen cannot be patched
+        render_plan plan = compile_render_plan(config.render_options, frame.col_width, config.col_padding);
+        out_buffer frame_output = { -1, move(frame_text), NULL };
+
+        frame_output.data.clear();
+
+        table_writer writer = { FORMAT_PRETTY, &frame_output, &plan, config.render_options.headerless, frame.col_width.size(), TEXT_ALIGN_LEFT, NULL, 0, 0, 0 };
+        size_t row_count = store_row_count(frame.store);
+
+        write_table_begin(writer);
+
+        for (size_t row_index = 0; row_index < row_count; ++row_index) {
+            size_t cell_begin = frame.store.row_offsets[row_index];
+
+            write_table_row(writer, &frame.store.cells[cell_begin], &frame.store.cell_widths[cell_begin], frame.store.row_offsets[row_index + 1] - cell_begin);
+        }
+
+        write_table_end(writer);
+
+        frame_text = move(frame_output.data);
+        frame.line_count = count(frame_text.begin(), frame_text.end(), NEWLINE);
+
+        bool is_patchable = (
+            shown_frame.line_count > 0 && frame.line_count == shown_frame.line_count &&
+            row_count == store_row_count(shown_frame.store) && frame.col_width == shown_frame.col_width &&
+            current_height == terminal_height && current_width == terminal_width &&
+            (current_height == 0 || frame.line_count < current_height)
+        );
+
+        if (is_patchable) patch_watch_frame(screen_output, shown_frame, frame, plan);
+        else {
+            out_write(screen_output, "\e[H\e[2J");
+            out_write(screen_output, frame_text);
+        }
+
+        out_flush(screen_output);
+
+        shown_index = 1 - shown_index;
+        terminal_height = current_height;
+        terminal_width = current_width;
+
+        // A command slower than the interval delays the next run instead of queueing runs
+        next_run = max(next_run + interval, chrono::steady_clock::now());
+
+        this_thread::sleep_until(next_run);
+    }
+}
+
+// --------------------------------------------------
+// Table Output
+// --------------------------------------------------
+
+/**
+ * @brief Decompresses an input into a pipe on a background thread.
+ *
+ * Used by --live and --stream, which read their input descriptor directly. SIGPIPE is
+ * blocked on the thread, so a reader that stops early only ends the decompression.
+ *
+ * @param input_fd        The compressed input descriptor.
+ * @param compression     The compression format of the input.
+ * @param decoder_thread  Receives the thread writing the pipe, joined once the pipe is closed.
+ * @param decoded         Set once the thread is done, `false` if the input could not be decompressed.
+ *
+ * @return The read end of the pipe, or -1 if no pipe could be created.
+ */
+int open_decoded_pipe(
+    const int &input_fd,
+    const input_compression &compression,
+    thread &decoder_thread,
+    bool &decoded
+) {
+    int pipe_fds[2];
+
+    if (pipe(pipe_fds) != 0) return -1;
+
+    decoder_thread = thread([input_fd, compression, pipe_fds, &decoded]() {
+        sigset_t pipe_signal;
+
+        sigemptyset(&pipe_signal);
+        sigaddset(&pipe_signal, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &pipe_signal, NULL);
+
+        string decode_error;
+
+        decoded = decode_input(input_fd, compression, [&](const char *block, size_t block_length) { return write_block(pipe_fds[1], block, block_length); }, false, decode_error);
+
+        if (!decoded) cerr << "Error: Unable to decompress the input: " << decode_error << endl;
+
+        close(pipe_fds[1]);
+    });
+
+    return pipe_fds[0];
+}
+
+/**
+ * @brief Writes a stored table as sections of the columns that fit the table width.
+ *
+ * Every section is a whole table with its own render plan, written in one pass over the
+ * rows and set apart from the previous section by an empty line.
+ *
+ * @param store          The stored table, the first row being the header unless headerless.
+ * @param footer_store   The store holding the footer rows.
+ * @param tab_col_width  The content width of each column.
+ * @param col_kinds      The numeric kind of each column, empty without --numeric.
+ * @param config         The configuration.
+ * @param table_output   The writer of stdout.
+ */
+void write_stacked_table(
+    const tab_store &store,
+    const tab_store &footer_store,
+    const vector<size_t> &tab_col_width,
+    const vector<number_kind> &col_kinds,
+    const tab_config &config,
+    out_buffer &table_output
+) {
+    vector<vector<size_t>> sections;
+    vector<string_view> section_row;             // Cells of the current row in the columns of the section
+    vector<size_t> section_widths;               // Display width of each of those cells
+
+    get_stack_sections(tab_col_width, config.max_table_width, config.col_padding, config.render_options.use_border, sections);
+
+    // Picks the cells of a stored row in the columns of a section, ragged rows lacking some
+    auto select_section_row = [&](const tab_store &rows, const size_t &row_index, const vector<size_t> &section_cols) {
+        size_t cell_begin = rows.row_offsets[row_index];
+        size_t cell_count = rows.row_offsets[row_index + 1] - cell_begin;
+
+        section_row.clear();
+        section_widths.clear();
+
+        for (const auto &col_index : section_cols) {
+            section_row.push_back(col_index < cell_count ? rows.cells[cell_begin + col_index] : string_view());
+            section_widths.push_back(col_index < cell_count ? rows.cell_widths[cell_begin + col_index] : 0);
+        }
+    };
+
+    for (size_t section_index = 0; section_index < sections.size(); ++section_index) {
+        const vector<size_t> &section_cols = sections[section_index];
+        vector<size_t> section_col_width;
+        vector<number_kind> section_kinds;
+
+        for (const auto &col_index : section_cols) {
+            section_col_width.push_back(tab_col_width[col_index]);
+            section_kinds.push_back(col_index < col_kinds.size() ? col_kinds[col_index] : NUMBER_NONE);
+        }
+
+        // A column too wide on its own is still narrowed to the width limits
+        clamp_col_widths(section_col_width, config.max_col_width, config.max_table_width, config.col_padding, config.render_options.use_border);
+
+        render_plan plan = compile_render_plan(config.render_options, section_col_width, config.col_padding);
+
+        if (config.use_numeric) align_numeric_cols(plan, section_kinds);
+
+        table_writer writer = { FORMAT_PRETTY, &table_output, &plan, config.render_options.headerless, section_cols.size(), TEXT_ALIGN_LEFT, NULL, 0, 0, 0 };
+        tab_store section_footer = {};
+
+        for (size_t row_index = 0; row_index < store_row_count(footer_store); ++row_index) {
+            select_section_row(footer_store, row_index, section_cols);
+            store_row(section_footer, section_row);
+        }
+
+        if (section_index > 0) out_write(table_output, NEWLINE);
+
+        write_table_begin(writer);
+
+        for (size_t row_index = 0; row_index < store_row_count(store); ++row_index) {
+            select_section_row(store, row_index, section_cols);
+            write_table_row(writer, section_row.data(), section_widths.data(), section_row.size());
+        }
+
+        write_table_footer(writer, section_footer);
+        write_table_end(writer);
+    }
+}
+
+/**
+ * @brief Lays out a stored table and writes it in the output formats.
+ *
+ * The column widths are measured from the stored cell widths unless given, clamped to the
+ * width limits, and compiled into a render plan when an output uses the pretty format.
+ * Every row is then written to stdout and to the tee file in one pass. A table written
+ * only as pretty to stdout is rendered on `config.jobs` threads. With --numeric or --footer,
+ * the column kinds and the footer rows come from the numbers the store cached. With --fit,
+ * a table wider than the width limit is shrunk, wrapped or stacked.
+ *
+ * @param store          The stored table, the first row being the header unless headerless.
+ * @param tab_col_width  The content width of each column, measured here if empty.
+ * @param config         The configuration.
+ * @param table_output   The writer of stdout.
+ * @param tee_output     The writer of the --tee file, or NULL.
+ * @param stats          The run statistics, timed as the widths and render phases.
+ */
+void write_table(
+    const tab_store &store,
+    vector<size_t> tab_col_width,
+    const tab_config &config,
+    out_buffer &table_output,
+    out_buffer *tee_output,
+    tab_stats &stats
+) {
+    size_t row_count = store_row_count(store);
+    size_t max_col_count = 0;
+    const vector<size_t> &row_offsets = store.row_offsets;
+
+    // Widths and styles are only needed by the pretty format
+    bool use_pretty = config.format == FORMAT_PRETTY || (tee_output != NULL && config.tee_format == FORMAT_PRETTY);
+
+    // --------------------------------------------------
+    // Determine Maximum Column Count
+    // --------------------------------------------------
+
+    // Finds the row with the most columns to standardize layout
+    for (size_t row_index = 0; row_index < row_count; ++row_index) max_col_count = max(max_col_count, row_offsets[row_index + 1] - row_offsets[row_index]);
+
+    // --------------------------------------------------
+    // Compute Column Widths for Alignment
+    // --------------------------------------------------
+
+    if (tab_col_width.empty()) {
+        tab_col_width.resize(max_col_count, 0);
+
+        // Iterates through all cells to calculate the maximum width needed per column
+        for (size_t row_index = 0; use_pretty && row_index < row_count; ++row_index) {
+            const size_t *cell_widths = &store.cell_widths[row_offsets[row_index]];
+            size_t cell_count = row_offsets[row_index + 1] - row_offsets[row_index];
+
+            for (size_t index = 0; index < cell_count; ++index) tab_col_width[index] = max(tab_col_width[index], cell_widths[index]);
+        }
+    }
+
+    // --------------------------------------------------
+    // Column Kinds and Footer Rows
+    // --------------------------------------------------
+
+    size_t first_body_row = config.render_options.headerless ? 0 : 1;
+    vector<number_kind> col_kinds;
+    tab_store footer_store = {};
+
+    if (store.parse_numbers) get_col_kinds(store, first_body_row, col_kinds);
+
+    if (!config.footer.empty()) {
+        vector<vector<string>> footer_rows;
+
+        get_footer_rows(store, first_body_row, col_kinds, config.footer, footer_rows);
+
+        for (const auto &footer_row : footer_rows) store_row(footer_store, vector<string_view>(footer_row.begin(), footer_row.end()));
+
+        // The footer cells take part in the column widths
+        for (size_t row_index = 0; use_pretty && row_index < footer_rows.size(); ++row_index) {
+            update_col_width(tab_col_width, &footer_store.cell_widths[footer_store.row_offsets[row_index]], footer_rows[row_index].size());
+        }
+    }
+
+    // Lay out a table wider than the terminal from the column widths alone
+    fit_layout layout = config.fit == FIT_AUTO ? choose_fit_layout(tab_col_width, config.max_table_width, config.col_padding, config.render_options.use_border) : config.fit;
+
+    if (use_pretty && layout == FIT_STACK) {
+        stats_end_phase(stats, PHASE_WIDTHS);
+
+        write_stacked_table(store, footer_store, tab_col_width, col_kinds, config, table_output);
+
+        stats.row_count += row_count;
+        stats.cell_count += store.cells.size();
+        stats.max_col_count = max(stats.max_col_count, max_col_count);
+
+        stats_end_phase(stats, PHASE_RENDER);
+
+        return;
+    }
+
+    // Narrow the columns to the width limits, so that padding never grows past them
+    clamp_col_widths(tab_col_width, config.max_col_width, config.max_table_width, config.col_padding, config.render_options.use_border);
+
+    // Compile the styles, alignments and widths once for the whole table
+    render_plan plan;
+
+    if (use_pretty) plan = compile_render_plan(config.render_options, tab_col_width, config.col_padding);
+
+    if (use_pretty && config.use_numeric) align_numeric_cols(plan, col_kinds);
+
+    if (use_pretty) plan.wrap_cells = layout == FIT_WRAP;
+
+    stats_end_phase(stats, PHASE_WIDTHS);
+
+    // --------------------------------------------------
+    // Render Output Table
+    // --------------------------------------------------
+
+    text_alignment markdown_align = get_text_alignment(config.render_options.body_text_align);
+
+    // Writers of the table and of its tee copy, both fed in the same pass over the rows
+    table_writer table_writers[] = {
+        { config.format, &table_output, &plan, config.render_options.headerless, max_col_count, markdown_align, NULL, 0, 0, 0 },
+        { config.tee_format, tee_output, &plan, config.render_options.headerless, max_col_count, markdown_align, NULL, 0, 0, 0 }
+    };
+
+    size_t writer_count = tee_output != NULL ? 2 : 1;
+
+    if (config.jobs > 1 && writer_count == 1 && config.format == FORMAT_PRETTY) {
+        render_table_parallel(table_output, store, plan, config.jobs);
+
+        table_writers[0].row_index = row_count;
+    }
+    else {
+        for (size_t writer_index = 0; writer_index < writer_count; ++writer_index) write_table_begin(table_writers[writer_index]);
+
+        for (size_t row_index = 0; row_index < row_count; ++row_index) {
+            size_t cell_begin = row_offsets[row_index];
+            size_t cell_count = row_offsets[row_index + 1] - cell_begin;
+
+            for (size_t writer_index = 0; writer_index < writer_count; ++writer_index) {
+                write_table_row(table_writers[writer_index], &store.cells[cell_begin], &store.cell_widths[cell_begin], cell_count);
+            }
+        }
+    }
+
+    // Render the footer rows, then the bottom border of the table if enabled
+    for (size_t writer_index = 0; writer_index < writer_count; ++writer_index) {
+        write_table_footer(table_writers[writer_index], footer_store);
+        write_table_end(table_writers[writer_index]);
+    }
+
+    stats.row_count += row_count;
+    stats.cell_count += store.cells.size();
+    stats.max_col_count = max(stats.max_col_count, max_col_count);
+
+    stats_end_phase(stats, PHASE_RENDER);
+}
+
+/**
+ * @brief Renders the input as configured, or runs the benchmark.
+ *
+ * @param config  The parsed configuration.
+ * @param stats   The run statistics, with the options phase timed.
+ *
+ * @return The process exit status.
+ */
+int run_table(
+    tab_config &config,
+    tab_stats &stats
+) {
+    // --fit takes the terminal width unless a table width is given
+    if (config.fit_terminal || (config.fit != FIT_NONE && config.max_table_width == 0)) config.max_table_width = get_terminal_width();
+
+    // Benchmark the given configuration, every theme and every border style
+    if (config.use_bench) {
+        vector<bench_variant> variants = { { "default", config.render_options, config.col_separator } };
+
+        for (const auto &theme : THEMES) {
+            bench_variant variant = { string("theme:") + theme.name, config.render_options, config.col_separator };
+
+            apply_theme(theme.name, variant.render_options, variant.col_separator);
+            variants.push_back(variant);
+        }
+
+        for (const auto &style_entry : BORDER_STYLES) {
+            bench_variant variant = { string("border:") + style_entry.name, config.render_options, config.col_separator };
+
+            variant.render_options.border_style = *style_entry.border_style;
+            variants.push_back(variant);
+        }
+
+        return run_bench(config.bench_row_count, config.bench_col_count, config.bench_cell_length, config.exclude_first_line, config.col_padding, variants, config.bench_baseline_path, config.bench_tolerance);
+    }
+
+    if (config.use_live && config.use_stream) {
+        cerr << "Error: The '--live' and '--stream' options cannot be used together" << endl << endl;
+        cerr << "Type '-h' or '--help' to show the help message" << endl;
+
+        return 1;  // Exit with error
+    }
+
+    if ((config.use_live || config.use_stream) && (config.format != FORMAT_PRETTY || !config.tee_path.empty())) {
+        cerr << "Error: The '--format' and '--tee' options cannot be used with '--live' or '--stream'" << endl << endl;
+        cerr << "Type '-h' or '--help' to show the help message" << endl;
+
+        return 1;  // Exit with error
+    }
+
+    if ((config.use_live || config.use_stream) && (config.head_rows > 0 || config.tail_rows > 0 || config.page_rows > 0 || config.sort.sort_col != SIZE_MAX)) {
+        cerr << "Error: The '--head', '--tail', '--page' and '--sort' options cannot be used with '--live' or '--stream'" << endl << endl;
+        cerr << "Type '-h' or '--help' to show the help message" << endl;
+
+        return 1;  // Exit with error
+    }
+
+    if (config.page_rows > 0 && config.sort.sort_col != SIZE_MAX) {
+        cerr << "Error: The '--page' and '--sort' options cannot be used together" << endl << endl;
+        cerr << "Type '-h' or '--help' to show the help message" << endl;
+
+        return 1;  // Exit with error
+    }
+
+    if (config.page_rows > 0 && (config.format != FORMAT_PRETTY || !config.tee_path.empty())) {
+        cerr << "Error: The '--page' option only applies to the pretty format" << endl << endl;
+        cerr << "Type '-h' or '--help' to show the help message" << endl;
+
+        return 1;  // Exit with error
+    }
+
+    if (config.watch_interval > 0 && (config.use_live || config.use_stream || config.page_rows > 0 || config.format != FORMAT_PRETTY || !config.tee_path.empty() || !config.usrinput_input_path.empty())) {
+        cerr << "Error: The '--watch' option cannot be used with '--live', '--stream', '--page', '--format', '--tee' or '--input'" << endl << endl;
+        cerr << "Type '-h' or '--help' to show the help message" << endl;
+
+        return 1;  // Exit with error
+    }
+
+    if ((config.use_numeric || !config.footer.empty()) && (config.use_live || config.use_stream || config.watch_interval > 0)) {
+        cerr << "Error: The '--numeric' and '--footer' options cannot be used with '--live', '--stream' or '--watch'" << endl << endl;
+        cerr << "Type '-h' or '--help' to show the help message" << endl;
+
+        return 1;  // Exit with error
+    }
+
+    if (config.fit != FIT_NONE && (config.use_live || config.use_stream || config.watch_interval > 0 || !config.tee_path.empty())) {
+        cerr << "Error: The '--fit' option cannot be used with '--live', '--stream', '--watch' or '--tee'" << endl << endl;
+        cerr << "Type '-h' or '--help' to show the help message" << endl;
+
+        return 1;  // Exit with error
+    }
+
+    // Open the input file, if any
+    int input_fd = STDIN_FILENO;
+
+    if (!config.usrinput_input_path.empty() && (input_fd = open(config.usrinput_input_path.c_str(), O_RDONLY)) < 0) {
+        cerr << "Error: Unable to open '" << config.usrinput_input_path << "': " << strerror(errno) << endl;
+
+        return 1;  // Exit with error
+    }
+
+    // Open the tee file, if any
+    int tee_fd = -1;
+
+    if (!config.tee_path.empty() && (tee_fd = open(config.tee_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+        cerr << "Error: Unable to open '" << config.tee_path << "': " << strerror(errno) << endl;
+
+        return 1;  // Exit with error
+    }
+
+    // Open the statistics file, if any
+    int stats_fd = config.use_stats ? STDERR_FILENO : -1;
+
+    if (!config.stats_path.empty() && (stats_fd = open(config.stats_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+        cerr << "Error: Unable to open '" << config.stats_path << "': " << strerror(errno) << endl;
+
+        return 1;  // Exit with error
+    }
+
+    // Compressed inputs are decompressed on the fly
+    input_compression compression = detect_compression(input_fd);
+    thread decoder_thread;
+    bool decoded = true;
+
+    if (compression != COMPRESSION_NONE && (config.use_live || config.use_stream) && (input_fd = open_decoded_pipe(input_fd, compression, decoder_thread, decoded)) < 0) {
+        cerr << "Error: Unable to create a pipe for the decompressed input: " << strerror(errno) << endl;
+
+        return 1;  // Exit with error
+    }
+
+    // Tokenizer settings shared by every input path
+    tab_parser cmdout_parser = make_parser(config.col_separator, config.exclude_first_line);
+
+    // Push the column selection and the row filter down into the tokenizer, a header row always passing
+    if (config.where_col != SIZE_MAX) filter_parser_rows(cmdout_parser, config.where_col, config.where_text, !config.exclude_first_line);
+
+    select_parser_columns(cmdout_parser, config.selected_cols);
+
+    // Keep the table of a command on the screen, redrawing the cells that change
+    if (config.watch_interval > 0) return write_stats(stats_fd, stats, watch_table(cmdout_parser, config));
+
+    // Render rows as they arrive, sampling at least one row unless widths are given
+    if (config.use_live) {
+        if (config.live_sample_rows == 0 && config.usrinput_col_width.empty()) config.live_sample_rows = 1;
+
+        int exit_status = live_table(input_fd, cmdout_parser, config.usrinput_header_data, config.col_padding, config.live_sample_rows, config.usrinput_col_width, config.max_col_width, config.max_table_width, config.render_options, stats);
+
+        // Closing the pipe first ends a decompression the table stopped reading
+        if (decoder_thread.joinable()) {
+            close(input_fd);
+            decoder_thread.join();
+        }
+
+        return write_stats(stats_fd, stats, decoded ? exit_status : 1);
+    }
+
+    // Render huge inputs in two passes with bounded memory
+    if (config.use_stream) {
+        int exit_status = stream_table(input_fd, cmdout_parser, config.usrinput_header_data, config.col_padding, config.max_col_width, config.max_table_width, config.render_options, stats);
+
+        if (decoder_thread.joinable()) {
+            close(input_fd);
+            decoder_thread.join();
+        }
+
+        return write_stats(stats_fd, stats, decoded ? exit_status : 1);
+    }
+
+    // --------------------------------------------------
+    // Variable Initialization
+    // --------------------------------------------------
+
+    vector<char> cmdout_block;                   // Buffer receiving raw blocks from the input
+    tab_store cmdout_tab_data = {};              // Columnar store holding all parsed table rows
+    vector<size_t> tab_col_width;                // Holds the maximum width of each column for alignment
+
+    size_t input_mapping_length = 0;             // Length of the memory mapped input
+
+    // Numbers are parsed once as the rows are stored, for the column kinds, the footer and --sort
+    cmdout_tab_data.parse_numbers = config.use_numeric || !config.footer.empty();
+
+    // Regular files are tokenized in place, cells then being views into the mapping
+    const char *input_mapping = compression == COMPRESSION_NONE ? map_input(input_fd, input_mapping_length) : NULL;
+
+    // Buffered writers for the table and its tee copy
+    out_buffer table_output = { STDOUT_FILENO, "", NULL };
+    out_buffer tee_output = { tee_fd, "", NULL };
+    out_buffer *tee_writer = tee_fd >= 0 ? &tee_output : NULL;
+
+    // Stores every completed row into the table data, without copying mapped cells
+    row_handler keep_row = [&](vector<string_view> &tab_row) {
+        store_row(cmdout_tab_data, tab_row, input_mapping, input_mapping + input_mapping_length);
+    };
+
+    // --------------------------------------------------
+    // Row Window (--head, --tail and --page)
+    // --------------------------------------------------
+
+    // A sorted table is windowed after sorting instead
+    bool use_window = (config.head_rows > 0 || config.tail_rows > 0 || config.page_rows > 0) && config.sort.sort_col == SIZE_MAX;
+    bool header_seen = config.render_options.headerless;  // Whether the header row has been stored
+    bool input_done = false;                     // Whether --head has all of its rows, ending the input early
+
+    size_t body_row_count = 0;                   // Body rows received so far
+    size_t page_row_count = 0;                   // Body rows stored on the current page
+    size_t page_count = 0;                       // Pages written so far
+
+    vector<string> header_cells;                 // Owned copy of the header, repeated on every page
+    vector<string_view> header_row;              // Views of the header cells
+    vector<vector<string>> tail_ring(config.tail_rows);  // The last --tail body rows, reused in a ring
+    vector<string_view> ring_row_view;           // Views of a ring row being stored
+
+    // Stores a body row, writing the page out once it is full
+    auto store_body_row = [&](const vector<string_view> &tab_row) {
+        store_row(cmdout_tab_data, tab_row, input_mapping, input_mapping + input_mapping_length);
+
+        if (config.page_rows == 0 || ++page_row_count < config.page_rows) return;
+
+        stats_end_phase(stats, PHASE_PARSE);
+
+        write_table(cmdout_tab_data, {}, config, table_output, tee_writer, stats);
+        store_clear(cmdout_tab_data);
+
+        if (!header_row.empty()) store_row(cmdout_tab_data, header_row);
+
+        page_row_count = 0;
+        ++page_count;
+    };
+
+    // Keeps the header, the first --head rows and the last --tail rows of the input
+    row_handler keep_window_row = [&](vector<string_view> &tab_row) {
+        if (input_done) return;
+
+        // The header, replaced with --hdata if given
+        if (!header_seen) {
+            header_seen = true;
+
+            if (!config.usrinput_header_data.empty() && !config.exclude_first_line) header_cells = config.usrinput_header_data;
+            else header_cells.assign(tab_row.begin(), tab_row.end());
+
+            header_row.assign(header_cells.begin(), header_cells.end());
+            store_row(cmdout_tab_data, header_row);
+
+            return;
+        }
+
+        size_t row_index = body_row_count++;
+
+        if (config.head_rows > 0 && row_index < config.head_rows) {
+            store_body_row(tab_row);
+
+            // Without --tail, nothing after the first rows is needed
+            if (config.tail_rows == 0 && row_index + 1 == config.head_rows) input_done = true;
+        }
+        else if (config.tail_rows > 0) {
+            vector<string> &ring_row = tail_ring[(row_index - config.head_rows) % config.tail_rows];
+
+            // Reuse the capacity of the row it replaces
+            ring_row.resize(tab_row.size());
+
+            for (size_t index = 0; index < tab_row.size(); ++index) ring_row[index].assign(tab_row[index]);
+        }
+        else if (config.head_rows == 0) store_body_row(tab_row);
+    };
+
+    if (config.jobs > 1 && !use_window && compression == COMPRESSION_NONE) {
+        // --------------------------------------------------
+        // Parallel Parsing and Column Widths
+        // --------------------------------------------------
+
+        const char *input = input_mapping;
+        size_t input_length = input_mapping_length;
+
+        if (input == NULL) {
+            read_all(input_fd, cmdout_block);
+
+            input = cmdout_block.data();
+            input_length = cmdout_block.size();
+        }
+        else input_byte_count.fetch_add(input_length, memory_order_relaxed);
+
+        if (config.exclude_first_line) config.usrinput_header_data.clear();
+
+        load_table_parallel(input, input_length, cmdout_parser, config.usrinput_header_data, config.jobs, cmdout_tab_data, tab_col_width);
+
+        stats_end_phase(stats, PHASE_PARSE);
+    }
+    else {
+        const row_handler &on_row = use_window ? keep_window_row : keep_row;
+
+        if (compression != COMPRESSION_NONE) {
+            // --------------------------------------------------
+            // Compressed Input Parsing
+            // --------------------------------------------------
+
+            // Decompressed blocks go straight into the tokenizer, pipelined on a second thread with --jobs
+            auto parse_decoded_block = [&](const char *block, size_t block_length) {
+                parse_block(cmdout_parser, block, block_length, on_row);
+
+                input_byte_count.fetch_add(block_length, memory_order_relaxed);
+
+                return !input_done;
+            };
+
+            string decode_error;
+
+            if (!decode_input(input_fd, compression, parse_decoded_block, config.jobs > 1, decode_error)) {
+                cerr << "Error: Unable to decompress the input: " << decode_error << endl;
+
+                return 1;  // Exit with error
+            }
+        }
+        else if (input_mapping != NULL) {
+            // --------------------------------------------------
+            // Memory Mapped Input Parsing
+            // --------------------------------------------------
+
+            // A window is parsed block by block, so that --head stops early
+            size_t slice_length = use_window ? READ_BLOCK_SIZE : input_mapping_length;
+
+            for (size_t offset = 0; offset < input_mapping_length && !input_done; offset += slice_length) {
+                size_t block_length = min(slice_length, input_mapping_length - offset);
+
+                parse_block(cmdout_parser, input_mapping + offset, block_length, on_row);
+
+                input_byte_count.fetch_add(block_length, memory_order_relaxed);
+            }
+        }
+        else {
+            // --------------------------------------------------
+            // Standard Input Parsing Loop
+            // --------------------------------------------------
+
+            // Left uninitialized, so a small input only touches the pages it fills
+            unique_ptr<char[]> read_buffer(new char[READ_BLOCK_SIZE]);
+
+            // Reads the input block by block and splits it into tokens and rows
+            ssize_t block_length;
+
+            while (!input_done && (block_length = read_block(input_fd, read_buffer.get(), READ_BLOCK_SIZE)) > 0) {
+                parse_block(cmdout_parser, read_buffer.get(), block_length, on_row);
+
+                input_byte_count.fetch_add(block_length, memory_order_relaxed);
+            }
+        }
+
+        // --------------------------------------------------
+        // Final Token and Row Flush (after EOF)
+        // --------------------------------------------------
+
+        parse_finish(cmdout_parser, on_row);
+
+        // The last rows follow the first ones, oldest first
+        if (config.tail_rows > 0 && body_row_count > config.head_rows) {
+            size_t ring_row_count = min(config.tail_rows, body_row_count - config.head_rows);
+            size_t ring_begin = (body_row_count - config.head_rows - ring_row_count) % config.tail_rows;
+
+            for (size_t index = 0; index < ring_row_count; ++index) {
+                const vector<string> &ring_row = tail_ring[(ring_begin + index) % config.tail_rows];
+
+                ring_row_view.assign(ring_row.begin(), ring_row.end());
+                store_body_row(ring_row_view);
+            }
+        }
+
+        // Sets the header data
+        if (!config.usrinput_header_data.empty() && !config.exclude_first_line && store_row_count(cmdout_tab_data) > 0) {
+            store_replace_row(cmdout_tab_data, 0, config.usrinput_header_data);
+
+            // Cleanup the memory
+            config.usrinput_header_data.clear();
+        }
+
+        stats_end_phase(stats, PHASE_PARSE);
+    }
+
+    // --------------------------------------------------
+    // Sort Body Rows
+    // --------------------------------------------------
+
+    if (config.sort.sort_col != SIZE_MAX) {
+        sort_table(cmdout_tab_data, config.sort, config.render_options.headerless ? 0 : 1, config.head_rows, config.tail_rows, config.jobs);
+
+        // The rows left out by --head and --tail may have been the widest
+        if (config.head_rows > 0 || config.tail_rows > 0) tab_col_width.clear();
+
+        stats_end_phase(stats, PHASE_SORT);
+    }
+
+    // --------------------------------------------------
+    // Render Output Table
+    // --------------------------------------------------
+
+    // The last page, unless the previous page ended exactly at the last row
+    if (page_count == 0 || page_row_count > 0) write_table(cmdout_tab_data, tab_col_width, config, table_output, tee_writer, stats);
+
+    store_clear(cmdout_tab_data);
+
+    out_flush(table_output);
+
+    if (tee_fd >= 0) {
+        out_flush(tee_output);
+        close(tee_fd);
+    }
+
+    stats_end_phase(stats, PHASE_RENDER);
 
     // Cleanup the memory
-    if (!table_color.empty()) table_color.clear();
+    unmap_input(input_mapping, input_mapping_length);
+
+    cmdout_block.clear();
 
     tab_col_width.clear();
 
-    // Exit successfully
-    return 0;
+    // Exit successfully, unless the statistics cannot be written
+    return write_stats(stats_fd, stats, 0);
+}
+
+// --------------------------------------------------
+// Server
+// --------------------------------------------------
+
+// Parsed configuration kept by --serve for the arguments of a run
+typedef struct serve_cache_entry {
+    string arguments;   // Arguments of the run, each ended by '\0'
+    tab_config config;  // Configuration parsed from the arguments
+} serve_cache_entry;
+
+// Least recently used cache of parsed configurations
+typedef struct serve_cache {
+    list<serve_cache_entry> entries;                                      // Entries, most recently used first
+    unordered_map<string_view, list<serve_cache_entry>::iterator> index;  // Entry of each argument string
+} serve_cache;
+
+/**
+ * @brief Gets the socket of the --serve daemon.
+ *
+ * @param serve_path  The socket given to --serve or --client, or empty for the default socket.
+ *
+ * @return The given socket, `$XDG_RUNTIME_DIR/tabstijl.sock`, or `/tmp/tabstijl-UID.sock`.
+ */
+string get_socket_path(const string &serve_path) {
+    if (!serve_path.empty()) return serve_path;
+
+    const char *runtime_dir = getenv("XDG_RUNTIME_DIR");
+
+    if (runtime_dir != NULL && runtime_dir[0] != VOID) return string(runtime_dir) + "/" PROGRAM_NAME ".sock";
+
+    return "/tmp/" PROGRAM_NAME "-" + to_string(getuid()) + ".sock";
+}
+
+/**
+ * @brief Fills the address of a Unix socket.
+ *
+ * @param socket_path  The socket file.
+ * @param address      Receives the address.
+ *
+ * @return `false` if the path does not fit in the address.
+ */
+bool make_socket_address(
+    const string &socket_path,
+    sockaddr_un &address
+) {
+    address = {};
+    address.sun_family = AF_UNIX;
+
+    if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) return false;
+
+    memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+    return true;
+}
+
+/**
+ * @brief Gets the configuration of a served run, parsing its arguments only when they are not cached.
+ *
+ * The arguments are parsed with stdout and stderr on those of the client, so that
+ * option errors and --help reach it. Only successfully parsed arguments are cached.
+ *
+ * @param cache        The cache of parsed configurations.
+ * @param arguments    The arguments of the run, each ended by '\0', the program name first.
+ * @param client_fds   The stdin, stdout and stderr of the client.
+ * @param config       Receives the configuration.
+ * @param exit_status  Receives the exit status of the run when the arguments stop it.
+ *
+ * @return `true` if the run should go on, `false` if it ends with `exit_status`.
+ */
+bool find_served_config(
+    serve_cache &cache,
+    const string &arguments,
+    const int *client_fds,
+    tab_config &config,
+    int &exit_status
+) {
+    auto found = cache.index.find(arguments);
+
+    if (found != cache.index.end()) {
+        cache.entries.splice(cache.entries.begin(), cache.entries, found->second);
+        config = found->second->config;
+
+        return true;
+    }
+
+    // Split the arguments in place
+    string argument_buffer = arguments;
+    vector<char *> argument_list;
+
+    for (size_t pos = 0; pos < argument_buffer.size(); pos = argument_buffer.find(VOID, pos) + 1) argument_list.push_back(&argument_buffer[pos]);
+
+    config = default_config();
+
+    int saved_stdout = dup(STDOUT_FILENO);
+    int saved_stderr = dup(STDERR_FILENO);
+
+    dup2(client_fds[STDOUT_FILENO], STDOUT_FILENO);
+    dup2(client_fds[STDERR_FILENO], STDERR_FILENO);
+
+    bool parsed = parse_options(argument_list.size(), argument_list.data(), config, exit_status);
+
+    if (parsed && config.use_serve) {
+        option_error("The '--serve' option cannot be sent to a daemon");
+
+        exit_status = 1;
+        parsed = false;
+    }
+
+    cout.flush();
+
+    dup2(saved_stdout, STDOUT_FILENO);
+    dup2(saved_stderr, STDERR_FILENO);
+    close(saved_stdout);
+    close(saved_stderr);
+
+    if (!parsed) return false;
+
+    cache.entries.push_front({ arguments, config });
+    cache.index[cache.entries.front().arguments] = cache.entries.begin();
+
+    if (cache.entries.size() > SERVE_CACHE_SIZE) {
+        cache.index.erase(cache.entries.back().arguments);
+        cache.entries.pop_back();
+    }
+
+    return true;
+}
+
+/**
+ * @brief Renders a served run in a forked daemon process and replies its exit status.
+ *
+ * The process takes over the standard streams and the directory of the client, so the
+ * table is read and written without passing through the daemon.
+ *
+ * @param listen_fd   The listening socket of the daemon, closed here.
+ * @param conn_fd     The connection of the client.
+ * @param client_fds  The stdin, stdout, stderr and directory of the client.
+ * @param config      The configuration of the run.
+ */
+[[noreturn]] void run_served_table(
+    const int &listen_fd,
+    const int &conn_fd,
+    const int *client_fds,
+    tab_config &config
+) {
+    close(listen_fd);
+
+    signal(SIGCHLD, SIG_DFL);
+    signal(SIGPIPE, SIG_DFL);
+
+    // The counters of a run start from zero, as in a new process
+    input_byte_count = 0;
+    output_byte_count = 0;
+    allocation_count = 0;
+
+    tab_stats stats = {};
+
+    stats.phase_start = stats_now();
+
+    for (int fd = STDIN_FILENO; fd <= STDERR_FILENO; ++fd) dup2(client_fds[fd], fd);
+
+    int exit_status = 1;
+
+    if (fchdir(client_fds[SERVE_FD_COUNT - 1]) != 0) {
+        cerr << "Error: Unable to enter the directory of the '--client' run" << endl;
+    }
+    else {
+        for (int index = 0; index < SERVE_FD_COUNT; ++index) {
+            if (client_fds[index] > STDERR_FILENO) close(client_fds[index]);
+        }
+
+        stats_end_phase(stats, PHASE_OPTIONS);
+
+        exit_status = run_table(config, stats);
+    }
+
+    cout.flush();
+
+    send(conn_fd, &exit_status, sizeof(exit_status), MSG_NOSIGNAL);
+
+    _exit(exit_status);
+}
+
+/**
+ * @brief Serves one connection of a --client run.
+ *
+ * The run arrives as one message holding its arguments, with its stdin, stdout, stderr
+ * and directory attached as file descriptors. A forked process renders the run and
+ * replies its exit status, the daemon itself replies when the arguments stop the run.
+ *
+ * @param listen_fd  The listening socket of the daemon.
+ * @param conn_fd    The accepted connection.
+ * @param cache      The cache of parsed configurations.
+ */
+void serve_request(
+    const int &listen_fd,
+    const int &conn_fd,
+    serve_cache &cache
+) {
+    // Only runs of the same user are served
+    ucred peer;
+    socklen_t peer_length = sizeof(peer);
+
+    if (getsockopt(conn_fd, SOL_SOCKET, SO_PEERCRED, &peer, &peer_length) != 0 || peer.uid != getuid()) return;
+
+    // A client that connects without sending its run is dropped instead of holding up the others
+    timeval receive_timeout = { SERVE_RECEIVE_TIMEOUT_MS / 1000, (SERVE_RECEIVE_TIMEOUT_MS % 1000) * 1000 };
+
+    if (setsockopt(conn_fd, SOL_SOCKET, SO_RCVTIMEO, &receive_timeout, sizeof(receive_timeout)) != 0) return;
+
+    static vector<char> message(SERVE_MESSAGE_SIZE);
+
+    int client_fds[SERVE_FD_COUNT];
+    size_t fd_count = 0;
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(client_fds))];
+
+    iovec message_io = { message.data(), message.size() };
+    msghdr header = {};
+
+    header.msg_iov = &message_io;
+    header.msg_iovlen = 1;
+    header.msg_control = control;
+    header.msg_controllen = sizeof(control);
+
+    ssize_t message_length = recvmsg(conn_fd, &header, MSG_CMSG_CLOEXEC);
+
+    for (cmsghdr *control_header = message_length >= 0 ? CMSG_FIRSTHDR(&header) : NULL; control_header != NULL; control_header = CMSG_NXTHDR(&header, control_header)) {
+        if (control_header->cmsg_level != SOL_SOCKET || control_header->cmsg_type != SCM_RIGHTS) continue;
+
+        fd_count = min<size_t>((control_header->cmsg_len - CMSG_LEN(0)) / sizeof(int), SERVE_FD_COUNT);
+        memcpy(client_fds, CMSG_DATA(control_header), fd_count * sizeof(int));
+    }
+
+    bool is_valid = message_length > 0 && message[message_length - 1] == VOID && fd_count == SERVE_FD_COUNT && (header.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) == 0;
+
+    int exit_status = 1;
+    bool replied = false;
+    tab_config config;
+
+    if (is_valid && find_served_config(cache, string(message.data(), message_length), client_fds, config, exit_status)) {
+        pid_t child_pid = fork();
+
+        if (child_pid == 0) run_served_table(listen_fd, conn_fd, client_fds, config);
+
+        if (child_pid > 0) replied = true;
+        else {
+            cerr << "Error: Unable to start a process for a '--client' run" << endl;
+
+            exit_status = 1;
+        }
+    }
+
+    if (!replied) send(conn_fd, &exit_status, sizeof(exit_status), MSG_NOSIGNAL);
+
+    for (size_t index = 0; index < fd_count; ++index) close(client_fds[index]);
+}
+
+/**
+ * @brief Runs the --serve daemon, rendering the tables of --client runs until it is stopped.
+ *
+ * Each run is rendered in a forked process, so a slow table does not hold up the daemon
+ * and a failing run cannot stop it. The daemon only waits for a connected client to send
+ * its run, for at most `SERVE_RECEIVE_TIMEOUT_MS`. The parsed configurations of the most
+ * recent distinct argument lists are cached, so that repeated runs skip option parsing.
+ *
+ * @param serve_path  The socket given to --serve, or empty for the default socket.
+ *
+ * @return The process exit status, 1 if the socket cannot be listened on.
+ */
+int serve_tables(const string &serve_path) {
+    string socket_path = get_socket_path(serve_path);
+    sockaddr_un address;
+
+    if (!make_socket_address(socket_path, address)) {
+        cerr << "Error: The socket path '" << socket_path << "' of the '--serve' option is too long" << endl;
+
+        return 1;  // Exit with error
+    }
+
+    int listen_fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+
+    if (listen_fd < 0) {
+        cerr << "Error: Unable to create the socket of the '--serve' option" << endl;
+
+        return 1;  // Exit with error
+    }
+
+    // A daemon already listening keeps its socket, the socket of a stopped daemon is replaced
+    struct stat socket_stat;
+
+    if (lstat(socket_path.c_str(), &socket_stat) == 0 && S_ISSOCK(socket_stat.st_mode)) {
+        if (connect(listen_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0) {
+            cerr << "Error: A '--serve' daemon is already listening on '" << socket_path << "'" << endl;
+
+            close(listen_fd);
+
+            return 1;  // Exit with error
+        }
+
+        unlink(socket_path.c_str());
+    }
+
+    // Only the user may connect
+    mode_t previous_umask = umask(0777 & ~SERVE_SOCKET_MODE);
+    bool is_listening = bind(listen_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0 && listen(listen_fd, SOMAXCONN) == 0;
+
+    umask(previous_umask);
+
+    if (!is_listening) {
+        cerr << "Error: Unable to listen on '" << socket_path << "' for the '--serve' option: " << strerror(errno) << endl;
+
+        close(listen_fd);
+
+        return 1;  // Exit with error
+    }
+
+    // Finished runs are reaped by the kernel, and clients that went away do not stop the daemon
+    signal(SIGCHLD, SIG_IGN);
+    signal(SIGPIPE, SIG_IGN);
+
+    serve_cache cache;
+
+    while (true) {
+        int conn_fd = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC);
+
+        if (conn_fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+
+            cerr << "Error: Unable to accept a '--client' run: " << strerror(errno) << endl;
+
+            close(listen_fd);
+
+            return 1;  // Exit with error
+        }
+
+        serve_request(listen_fd, conn_fd, cache);
+
+        close(conn_fd);
+    }
+}
+
+/**
+ * @brief Sends a run to the --serve daemon and waits for its exit status.
+ *
+ * The arguments are sent in one message, along with the stdin, stdout, stderr and
+ * directory of this process, on which the daemon reads and writes the table. They are
+ * only sent to a socket owned by the user with `SERVE_SOCKET_MODE` permissions, and
+ * to a daemon running as the user.
+ *
+ * @param serve_path   The socket given to --client, or empty for the default socket.
+ * @param argc         Number of arguments, the first one being skipped.
+ * @param argv         The arguments of the run, the first one being skipped.
+ * @param exit_status  Receives the exit status of the run.
+ *
+ * @return `false` if no daemon can take the run, which is then rendered locally.
+ */
+bool run_client(
+    const string &serve_path,
+    int argc,
+    char *argv[],
+    int &exit_status
+) {
+    // The program name keeps the message from being empty
+    string arguments = PROGRAM_NAME;
+
+    arguments += VOID;
+
+    for (int index = 1; index < argc; ++index) {
+        arguments += argv[index];
+        arguments += VOID;
+    }
+
+    string socket_path = get_socket_path(serve_path);
+    sockaddr_un address;
+
+    if (arguments.size() > SERVE_MESSAGE_SIZE || !make_socket_address(socket_path, address)) return false;
+
+    // A socket another user could have created is never trusted with the descriptors
+    struct stat socket_stat;
+
+    if (lstat(socket_path.c_str(), &socket_stat) != 0 || !S_ISSOCK(socket_stat.st_mode) || socket_stat.st_uid != getuid() || (socket_stat.st_mode & 07777) != SERVE_SOCKET_MODE) return false;
+
+    int socket_fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+
+    if (socket_fd < 0) return false;
+
+    // The daemon listening on the socket must run as the user too
+    ucred peer;
+    socklen_t peer_length = sizeof(peer);
+    int cwd_fd = -1;
+
+    if (
+        connect(socket_fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || 
+        getsockopt(socket_fd, SOL_SOCKET, SO_PEERCRED, &peer, &peer_length) != 0 || 
+        peer.uid != getuid() || 
+        (cwd_fd = open(".", O_RDONLY | O_DIRECTORY | O_CLOEXEC)) < 0
+    ) {
+        close(socket_fd);
+
+        return false;
+    }
+
+    int client_fds[SERVE_FD_COUNT] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO, cwd_fd };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(client_fds))] = {};
+
+    iovec message_io = { &arguments[0], arguments.size() };
+    msghdr header = {};
+
+    header.msg_iov = &message_io;
+    header.msg_iovlen = 1;
+    header.msg_control = control;
+    header.msg_controllen = sizeof(control);
+
+    cmsghdr *control_header = CMSG_FIRSTHDR(&header);
+
+    control_header->cmsg_level = SOL_SOCKET;
+    control_header->cmsg_type = SCM_RIGHTS;
+    control_header->cmsg_len = CMSG_LEN(sizeof(client_fds));
+    memcpy(CMSG_DATA(control_header), client_fds, sizeof(client_fds));
+
+    bool is_sent = sendmsg(socket_fd, &header, MSG_NOSIGNAL) == static_cast<ssize_t>(arguments.size());
+
+    close(cwd_fd);
+
+    if (!is_sent) {
+        close(socket_fd);
+
+        return false;
+    }
+
+    // The daemon replies once the run ended
+    ssize_t received;
+
+    do received = recv(socket_fd, &exit_status, sizeof(exit_status), MSG_WAITALL);
+    while (received < 0 && errno == EINTR);
+
+    close(socket_fd);
+
+    if (received != sizeof(exit_status)) {
+        cerr << "Error: The '--serve' daemon stopped before the end of the run" << endl;
+
+        exit_status = 1;
+    }
+
+    return true;
+}
+
+// The fuzz harnesses include this file for parse_options() and bring their own entry point
+#ifndef TABSTIJL_NO_MAIN
+
+int main(
+    int argc, 
+    char *argv[]
+) {
+    // Send the run to a --serve daemon, rendering it locally when no daemon takes it
+    if (argc > 1 && string_view(argv[1]).substr(0, 8) == "--client" && (argv[1][8] == VOID || argv[1][8] == '=')) {
+        string serve_path = argv[1][8] == '=' ? argv[1] + 9 : "";
+        int exit_status;
+
+        if (run_client(serve_path, argc - 1, argv + 1, exit_status)) return exit_status;
+
+        argv[1] = argv[0];
+        --argc;
+        ++argv;
+    }
+
+    // Command-line configuration, holding the defaults until the options are parsed
+    tab_config config = default_config();
+
+    // Run statistics, timed from here on
+    tab_stats stats = {};
+
+    stats.phase_start = stats_now();
+
+    // --------------------------------------------------
+    // Option Handlers
+    // --------------------------------------------------
+
+    int exit_status;
+
+    if (!parse_options(argc, argv, config, exit_status)) return exit_status;
+
+    stats_end_phase(stats, PHASE_OPTIONS);
+
+    if (config.use_serve) return serve_tables(config.serve_path);
+
+    return run_table(config, stats);
 }
+
+#endif
@@ -0,0 +1,3189 @@
+// MIT License
+
+// Copyright (c) 2025 Naufal Hanif
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file tabstijl.cpp
+ *
+ * @brief Implements libtabstijl, the tokenizer, layout and rendering engine of tabstijl.
+ *
+ * The functions are documented at their declarations in `tabstijl.hpp` and `tabstijl_cli.hpp`.
+ *
+ * @author Naufal Hanif
+ * @date 2025
+ */
+
+#include "tabstijl.hpp"
+#include "tabstijl_cli.hpp"
+
+// --------------------------------------------------
+// Standard Library Includes
+// --------------------------------------------------
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+// --------------------------------------------------
+// POSIX Includes
+// --------------------------------------------------
+
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/ioctl.h>
+#include <fcntl.h>
+
+// --------------------------------------------------
+// Decompression Includes
+// --------------------------------------------------
+
+#ifdef TABSTIJL_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef TABSTIJL_ZSTD
+#include <zstd.h>
+#endif
+
+namespace tabstijl {
+
+// Namespace declarations
+using namespace std;  // Use standard namespace inside the library sources only
+
+// Marks the end of a truncated cell (U+2026, one column wide)
+static constexpr char ELLIPSIS[] = "\xe2\x80\xa6";
+
+// I/O pipeline of --live and --stream
+static constexpr size_t PIPELINE_QUEUE_SLOTS = 4;  // Blocks in flight between two pipeline stages
+
+// Cell store
+static constexpr size_t ARENA_BLOCK_SIZE = 1 << 20;  // Minimum number of bytes allocated per arena block
+
+// Parallel mode
+static constexpr size_t SORT_PARALLEL_ROWS = 65536;  // Rows below which --sort runs on one thread
+
+string get_tab_border(
+    const size_t &max_col_count, 
+    const vector<size_t> &col_width, 
+    const string_view &left_char_unicode, 
+    const string_view &mid_char_unicode, 
+    const string_view &right_char_unicode, 
+    const string_view &fill_char_unicode,
+    const string &table_color
+) {    
+    int temp_col_width = 0, max_col_width = 0;
+    size_t max_fill_width = 0, total_fill_width = 0;
+
+    // Calculate the total width of the border by summing column widths
+    for (size_t index = 0; index < col_width.size(); index++) max_col_width += col_width[index];
+
+    for (size_t index = 0; index < max_col_count; index++) {
+        max_fill_width = max(max_fill_width, col_width[index]);
+        total_fill_width += col_width[index];
+    }
+
+    max_col_width -= col_width.size() - 1;  // Adjust for junctions
+
+    // Fill characters of every column are copied from one pattern block, sized for the widest column
+    fill_pattern fill_run = make_fill_pattern(fill_char_unicode, max_fill_width);
+
+    string result = table_color;  // Apply color to the border
+
+    result.reserve(result.length() + left_char_unicode.length() + max_col_count * mid_char_unicode.length() + total_fill_width * fill_char_unicode.length() + right_char_unicode.length() + sizeof(DEFAULT));
+    result += left_char_unicode;
+
+    for (size_t st_index = 0; st_index < max_col_count; ++st_index) {
+        temp_col_width += col_width[st_index] - 1;
+
+        if (col_width[st_index] == 0) continue;
+
+        append_fill_run(result, fill_run, col_width[st_index]);
+
+        // Insert a mid junction character between columns when appropriate
+        if (temp_col_width < max_col_width - 1) result += mid_char_unicode;
+    }
+
+    result += right_char_unicode;
+    result += DEFAULT;
+    result += NEWLINE;
+
+    return result;
+}
+
+bool is_wspace(
+    const char &current_char,
+    const char &col_separator
+) {
+    if (col_separator == NEWLINE || col_separator == SPACE || col_separator == TAB) {
+        return current_char == col_separator || current_char == NEWLINE;
+    } else {
+        return isspace(static_cast<unsigned char>(current_char));
+    }
+}
+
+tab_parser make_parser(
+    const char &col_separator,
+    const bool &exclude_first_line
+) {
+    tab_parser parser;
+
+    parser.col_separator = col_separator;
+    parser.exclude_first_line = exclude_first_line;
+    parser.first_line = true;
+    parser.last_col_index = SIZE_MAX;
+    parser.where_col = SIZE_MAX;
+    parser.header_pending = false;
+    parser.col_index = 0;
+    parser.row_rejected = false;
+
+    for (int byte_value = 0; byte_value < 256; ++byte_value) parser.separator_table[byte_value] = is_wspace(static_cast<char>(byte_value), col_separator);
+
+    return parser;
+}
+
+void select_parser_columns(
+    tab_parser &parser,
+    const vector<size_t> &selected_cols
+) {
+    if (selected_cols.empty()) return;
+
+    size_t last_col_index = *max_element(selected_cols.begin(), selected_cols.end());
+
+    parser.col_slots.assign(last_col_index + 1, -1);
+
+    for (size_t slot = 0; slot < selected_cols.size(); ++slot) parser.col_slots[selected_cols[slot]] = slot;
+
+    parser.last_col_index = parser.where_col == SIZE_MAX ? last_col_index : max(last_col_index, parser.where_col);
+}
+
+void filter_parser_rows(
+    tab_parser &parser,
+    const size_t &where_col,
+    const string &where_text,
+    const bool &keep_header_row
+) {
+    parser.where_col = where_col;
+    parser.where_text = where_text;
+    parser.header_pending = keep_header_row;
+
+    if (parser.last_col_index != SIZE_MAX) parser.last_col_index = max(parser.last_col_index, where_col);
+}
+
+/**
+ * @brief Checks whether any byte of a 64-bit word equals the byte replicated in `pattern`.
+ *
+ * Classic SWAR zero-byte test applied to `word ^ pattern`. It only reports presence,
+ * so callers must locate the matching byte themselves.
+ *
+ * @param word     Eight input bytes loaded as one word.
+ * @param pattern  The byte to look for, replicated into every byte of the word.
+ *
+ * @return Non-zero if at least one byte of `word` matches.
+ */
+static inline uint64_t has_byte(
+    const uint64_t &word,
+    const uint64_t &pattern
+) {
+    uint64_t masked_word = word ^ pattern;
+
+    return (masked_word - 0x0101010101010101ULL) & ~masked_word & 0x8080808080808080ULL;
+}
+
+/**
+ * @brief Checks whether any byte of a 64-bit word is a control character or a space.
+ *
+ * SWAR test for bytes below 0x21, which covers every whitespace byte. Bytes of 0x80 and
+ * above are never reported. It only reports presence, so callers must locate the byte.
+ *
+ * @param word  Eight input bytes loaded as one word.
+ *
+ * @return Non-zero if at least one byte of `word` is below 0x21.
+ */
+static inline uint64_t has_blank_byte(const uint64_t &word) {
+    return (word - 0x2121212121212121ULL) & ~word & 0x8080808080808080ULL;
+}
+
+const char *find_separator(
+    const char *block_begin,
+    const char *block_end,
+    const tab_parser &parser
+) {
+    const char *cursor = block_begin;
+    const bool *separator_table = parser.separator_table;
+
+    if (parser.col_separator == NEWLINE) {
+        const void *found = memchr(cursor, NEWLINE, block_end - cursor);
+
+        return found ? static_cast<const char *>(found) : block_end;
+    }
+
+    bool explicit_separator = parser.col_separator == SPACE || parser.col_separator == TAB;
+
+    const uint64_t newline_pattern = 0x0101010101010101ULL * static_cast<unsigned char>(NEWLINE);
+    const uint64_t separator_pattern = 0x0101010101010101ULL * static_cast<unsigned char>(parser.col_separator);
+
+    while (cursor < block_end) {
+        // Skip whole words that cannot contain a separator
+        while (block_end - cursor >= 8) {
+            uint64_t word;
+
+            memcpy(&word, cursor, sizeof(word));
+
+            if (explicit_separator ? has_byte(word, newline_pattern) || has_byte(word, separator_pattern) : has_blank_byte(word)) break;
+
+            cursor += 8;
+        }
+
+        // Classify the bytes of the candidate word (or the tail of the block)
+        const char *word_end = min(cursor + 8, block_end);
+
+        for (; cursor < word_end; ++cursor) {
+            if (separator_table[static_cast<unsigned char>(*cursor)]) return cursor;
+        }
+    }
+
+    return block_end;
+}
+
+/**
+ * @brief Adds a completed token to the current row, applying the column selection and filter.
+ *
+ * @param parser   The tokenizer state.
+ * @param token    The token, a view into the block or `pending_token`.
+ * @param carried  Whether the token is `pending_token`, which is moved into `carried_cells` if kept.
+ */
+static inline void keep_token(
+    tab_parser &parser,
+    string_view token,
+    const bool &carried
+) {
+    size_t col_index = parser.col_index++;
+
+    if (col_index == parser.where_col && !parser.header_pending && token.find(parser.where_text) == string_view::npos) parser.row_rejected = true;
+
+    bool selected = parser.col_slots.empty() || (col_index < parser.col_slots.size() && parser.col_slots[col_index] >= 0);
+
+    if (!selected) return;
+
+    if (carried) {
+        parser.carried_cells.push_back(move(parser.pending_token));
+        token = parser.carried_cells.back();
+    }
+
+    if (parser.col_slots.empty()) parser.temp_row_data.push_back(token);
+    else {
+        size_t slot = parser.col_slots[col_index];
+
+        // Columns selected before this one but missing from the row stay empty
+        if (parser.temp_row_data.size() <= slot) parser.temp_row_data.resize(slot + 1);
+
+        parser.temp_row_data[slot] = token;
+    }
+}
+
+/**
+ * @brief Hands the current row over unless it failed the filter, then starts the next row.
+ *
+ * @param parser  The tokenizer state.
+ * @param on_row  Callback receiving the row.
+ */
+static inline void end_row(
+    tab_parser &parser,
+    const row_handler &on_row
+) {
+    bool rejected = parser.row_rejected || (parser.where_col != SIZE_MAX && parser.col_index <= parser.where_col);
+
+    // The header always passes
+    if (parser.header_pending && parser.col_index > 0) {
+        rejected = false;
+        parser.header_pending = false;
+    }
+
+    if (!rejected && !parser.temp_row_data.empty()) on_row(parser.temp_row_data);
+
+    parser.temp_row_data.clear();
+    parser.col_index = 0;
+    parser.row_rejected = false;
+}
+
+void parse_block(
+    tab_parser &parser,
+    const char *block,
+    const size_t &block_length,
+    const row_handler &on_row
+) {
+    const char *cursor = block;
+    const char *block_end = block + block_length;
+
+    while (cursor < block_end) {
+        // The rest of a rejected row, or of a row past its last needed column, is not tokenized
+        bool skip_row = parser.row_rejected || parser.col_index > parser.last_col_index;
+
+        const char *separator = skip_row ? static_cast<const char *>(memchr(cursor, NEWLINE, block_end - cursor)) : find_separator(cursor, block_end, parser);
+
+        if (separator == NULL) break;
+
+        // Keep the unfinished token for the next block
+        if (separator == block_end) {
+            parser.pending_token.append(cursor, block_end - cursor);
+
+            break;
+        }
+
+        // Push token into row data unless excluded as a header
+        if (!skip_row && (!parser.first_line || !parser.exclude_first_line)) {
+            if (!parser.pending_token.empty()) {
+                parser.pending_token.append(cursor, separator - cursor);
+                keep_token(parser, parser.pending_token, true);
+            }
+            else if (separator > cursor) keep_token(parser, string_view(cursor, separator - cursor), false);
+        }
+
+        parser.pending_token.clear();
+
+        cursor = separator + 1;
+
+        // If newline, treat as end of row
+        if (*separator == NEWLINE) {
+            // Skip the first line if headerless mode is on
+            if (parser.first_line && parser.exclude_first_line) {
+                parser.first_line = false;
+
+                continue;
+            }
+
+            // Hand the completed row over
+            end_row(parser, on_row);
+
+            parser.carried_cells.clear();
+        }
+    }
+
+    // Copy tokens that still point into this block before it is reused
+    for (auto &tab_cell : parser.temp_row_data) {
+        if (tab_cell.data() >= block && tab_cell.data() < block_end) {
+            parser.carried_cells.emplace_back(tab_cell);
+
+            tab_cell = parser.carried_cells.back();
+        }
+    }
+}
+
+void parse_finish(
+    tab_parser &parser,
+    const row_handler &on_row
+) {
+    // Ensure any remaining characters are captured as the last token
+    if (!parser.pending_token.empty()) keep_token(parser, parser.pending_token, true);
+
+    parser.pending_token.clear();
+
+    // Hand the last row over if not empty
+    end_row(parser, on_row);
+
+    parser.carried_cells.clear();
+}
+
+// Inclusive range of Unicode code points
+typedef struct unicode_range {
+    uint32_t first;  // First code point of the range
+    uint32_t last;   // Last code point of the range
+} unicode_range;
+
+// Code points that take no column: combining marks, format characters and Hangul medial vowels
+// (Unicode 14.0, unassigned gaps between ranges are merged)
+static const unicode_range ZERO_WIDTH_RANGES[] = {
+    { 0x0300, 0x036F }, { 0x0483, 0x0489 }, { 0x0591, 0x05BD }, { 0x05BF, 0x05BF },
+    { 0x05C1, 0x05C2 }, { 0x05C4, 0x05C5 }, { 0x05C7, 0x05C7 }, { 0x0600, 0x0605 },
+    { 0x0610, 0x061A }, { 0x061C, 0x061C }, { 0x064B, 0x065F }, { 0x0670, 0x0670 },
+    { 0x06D6, 0x06DD }, { 0x06DF, 0x06E4 }, { 0x06E7, 0x06E8 }, { 0x06EA, 0x06ED },
+    { 0x070F, 0x070F }, { 0x0711, 0x0711 }, { 0x0730, 0x074A }, { 0x07A6, 0x07B0 },
+    { 0x07EB, 0x07F3 }, { 0x07FD, 0x07FD }, { 0x0816, 0x0819 }, { 0x081B, 0x0823 },
+    { 0x0825, 0x0827 }, { 0x0829, 0x082D }, { 0x0859, 0x085B }, { 0x0890, 0x089F },
+    { 0x08CA, 0x0902 }, { 0x093A, 0x093A }, { 0x093C, 0x093C }, { 0x0941, 0x0948 },
+    { 0x094D, 0x094D }, { 0x0951, 0x0957 }, { 0x0962, 0x0963 }, { 0x0981, 0x0981 },
+    { 0x09BC, 0x09BC }, { 0x09C1, 0x09C4 }, { 0x09CD, 0x09CD }, { 0x09E2, 0x09E3 },
+    { 0x09FE, 0x0A02 }, { 0x0A3C, 0x0A3C }, { 0x0A41, 0x0A51 }, { 0x0A70, 0x0A71 },
+    { 0x0A75, 0x0A75 }, { 0x0A81, 0x0A82 }, { 0x0ABC, 0x0ABC }, { 0x0AC1, 0x0AC8 },
+    { 0x0ACD, 0x0ACD }, { 0x0AE2, 0x0AE3 }, { 0x0AFA, 0x0B01 }, { 0x0B3C, 0x0B3C },
+    { 0x0B3F, 0x0B3F }, { 0x0B41, 0x0B44 }, { 0x0B4D, 0x0B56 }, { 0x0B62, 0x0B63 },
+    { 0x0B82, 0x0B82 }, { 0x0BC0, 0x0BC0 }, { 0x0BCD, 0x0BCD }, { 0x0C00, 0x0C00 },
+    { 0x0C04, 0x0C04 }, { 0x0C3C, 0x0C3C }, { 0x0C3E, 0x0C40 }, { 0x0C46, 0x0C56 },
+    { 0x0C62, 0x0C63 }, { 0x0C81, 0x0C81 }, { 0x0CBC, 0x0CBC }, { 0x0CBF, 0x0CBF },
+    { 0x0CC6, 0x0CC6 }, { 0x0CCC, 0x0CCD }, { 0x0CE2, 0x0CE3 }, { 0x0D00, 0x0D01 },
+    { 0x0D3B, 0x0D3C }, { 0x0D41, 0x0D44 }, { 0x0D4D, 0x0D4D }, { 0x0D62, 0x0D63 },
+    { 0x0D81, 0x0D81 }, { 0x0DCA, 0x0DCA }, { 0x0DD2, 0x0DD6 }, { 0x0E31, 0x0E31 },
+    { 0x0E34, 0x0E3A }, { 0x0E47, 0x0E4E }, { 0x0EB1, 0x0EB1 }, { 0x0EB4, 0x0EBC },
+    { 0x0EC8, 0x0ECD }, { 0x0F18, 0x0F19 }, { 0x0F35, 0x0F35 }, { 0x0F37, 0x0F37 },
+    { 0x0F39, 0x0F39 }, { 0x0F71, 0x0F7E }, { 0x0F80, 0x0F84 }, { 0x0F86, 0x0F87 },
+    { 0x0F8D, 0x0FBC }, { 0x0FC6, 0x0FC6 }, { 0x102D, 0x1030 }, { 0x1032, 0x1037 },
+    { 0x1039, 0x103A }, { 0x103D, 0x103E }, { 0x1058, 0x1059 }, { 0x105E, 0x1060 },
+    { 0x1071, 0x1074 }, { 0x1082, 0x1082 }, { 0x1085, 0x1086 }, { 0x108D, 0x108D },
+    { 0x109D, 0x109D }, { 0x1160, 0x11FF }, { 0x135D, 0x135F }, { 0x1712, 0x1714 },
+    { 0x1732, 0x1733 }, { 0x1752, 0x1753 }, { 0x1772, 0x1773 }, { 0x17B4, 0x17B5 },
+    { 0x17B7, 0x17BD }, { 0x17C6, 0x17C6 }, { 0x17C9, 0x17D3 }, { 0x17DD, 0x17DD },
+    { 0x180B, 0x180F }, { 0x1885, 0x1886 }, { 0x18A9, 0x18A9 }, { 0x1920, 0x1922 },
+    { 0x1927, 0x1928 }, { 0x1932, 0x1932 }, { 0x1939, 0x193B }, { 0x1A17, 0x1A18 },
+    { 0x1A1B, 0x1A1B }, { 0x1A56, 0x1A56 }, { 0x1A58, 0x1A60 }, { 0x1A62, 0x1A62 },
+    { 0x1A65, 0x1A6C }, { 0x1A73, 0x1A7F }, { 0x1AB0, 0x1B03 }, { 0x1B34, 0x1B34 },
+    { 0x1B36, 0x1B3A }, { 0x1B3C, 0x1B3C }, { 0x1B42, 0x1B42 }, { 0x1B6B, 0x1B73 },
+    { 0x1B80, 0x1B81 }, { 0x1BA2, 0x1BA5 }, { 0x1BA8, 0x1BA9 }, { 0x1BAB, 0x1BAD },
+    { 0x1BE6, 0x1BE6 }, { 0x1BE8, 0x1BE9 }, { 0x1BED, 0x1BED }, { 0x1BEF, 0x1BF1 },
+    { 0x1C2C, 0x1C33 }, { 0x1C36, 0x1C37 }, { 0x1CD0, 0x1CD2 }, { 0x1CD4, 0x1CE0 },
+    { 0x1CE2, 0x1CE8 }, { 0x1CED, 0x1CED }, { 0x1CF4, 0x1CF4 }, { 0x1CF8, 0x1CF9 },
+    { 0x1DC0, 0x1DFF }, { 0x200B, 0x200F }, { 0x202A, 0x202E }, { 0x2060, 0x206F },
+    { 0x20D0, 0x20F0 }, { 0x2CEF, 0x2CF1 }, { 0x2D7F, 0x2D7F }, { 0x2DE0, 0x2DFF },
+    { 0x302A, 0x302D }, { 0x3099, 0x309A }, { 0xA66F, 0xA672 }, { 0xA674, 0xA67D },
+    { 0xA69E, 0xA69F }, { 0xA6F0, 0xA6F1 }, { 0xA802, 0xA802 }, { 0xA806, 0xA806 },
+    { 0xA80B, 0xA80B }, { 0xA825, 0xA826 }, { 0xA82C, 0xA82C }, { 0xA8C4, 0xA8C5 },
+    { 0xA8E0, 0xA8F1 }, { 0xA8FF, 0xA8FF }, { 0xA926, 0xA92D }, { 0xA947, 0xA951 },
+    { 0xA980, 0xA982 }, { 0xA9B3, 0xA9B3 }, { 0xA9B6, 0xA9B9 }, { 0xA9BC, 0xA9BD },
+    { 0xA9E5, 0xA9E5 }, { 0xAA29, 0xAA2E }, { 0xAA31, 0xAA32 }, { 0xAA35, 0xAA36 },
+    { 0xAA43, 0xAA43 }, { 0xAA4C, 0xAA4C }, { 0xAA7C, 0xAA7C }, { 0xAAB0, 0xAAB0 },
+    { 0xAAB2, 0xAAB4 }, { 0xAAB7, 0xAAB8 }, { 0xAABE, 0xAABF }, { 0xAAC1, 0xAAC1 },
+    { 0xAAEC, 0xAAED }, { 0xAAF6, 0xAAF6 }, { 0xABE5, 0xABE5 }, { 0xABE8, 0xABE8 },
+    { 0xABED, 0xABED }, { 0xFB1E, 0xFB1E }, { 0xFE00, 0xFE0F }, { 0xFE20, 0xFE2F },
+    { 0xFEFF, 0xFEFF }, { 0xFFF9, 0xFFFB }, { 0x101FD, 0x101FD }, { 0x102E0, 0x102E0 },
+    { 0x10376, 0x1037A }, { 0x10A01, 0x10A0F }, { 0x10A38, 0x10A3F }, { 0x10AE5, 0x10AE6 },
+    { 0x10D24, 0x10D27 }, { 0x10EAB, 0x10EAC }, { 0x10F46, 0x10F50 }, { 0x10F82, 0x10F85 },
+    { 0x11001, 0x11001 }, { 0x11038, 0x11046 }, { 0x11070, 0x11070 }, { 0x11073, 0x11074 },
+    { 0x1107F, 0x11081 }, { 0x110B3, 0x110B6 }, { 0x110B9, 0x110BA }, { 0x110BD, 0x110BD },
+    { 0x110C2, 0x110CD }, { 0x11100, 0x11102 }, { 0x11127, 0x1112B }, { 0x1112D, 0x11134 },
+    { 0x11173, 0x11173 }, { 0x11180, 0x11181 }, { 0x111B6, 0x111BE }, { 0x111C9, 0x111CC },
+    { 0x111CF, 0x111CF }, { 0x1122F, 0x11231 }, { 0x11234, 0x11234 }, { 0x11236, 0x11237 },
+    { 0x1123E, 0x1123E }, { 0x112DF, 0x112DF }, { 0x112E3, 0x112EA }, { 0x11300, 0x11301 },
+    { 0x1133B, 0x1133C }, { 0x11340, 0x11340 }, { 0x11366, 0x11374 }, { 0x11438, 0x1143F },
+    { 0x11442, 0x11444 }, { 0x11446, 0x11446 }, { 0x1145E, 0x1145E }, { 0x114B3, 0x114B8 },
+    { 0x114BA, 0x114BA }, { 0x114BF, 0x114C0 }, { 0x114C2, 0x114C3 }, { 0x115B2, 0x115B5 },
+    { 0x115BC, 0x115BD }, { 0x115BF, 0x115C0 }, { 0x115DC, 0x115DD }, { 0x11633, 0x1163A },
+    { 0x1163D, 0x1163D }, { 0x1163F, 0x11640 }, { 0x116AB, 0x116AB }, { 0x116AD, 0x116AD },
+    { 0x116B0, 0x116B5 }, { 0x116B7, 0x116B7 }, { 0x1171D, 0x1171F }, { 0x11722, 0x11725 },
+    { 0x11727, 0x1172B }, { 0x1182F, 0x11837 }, { 0x11839, 0x1183A }, { 0x1193B, 0x1193C },
+    { 0x1193E, 0x1193E }, { 0x11943, 0x11943 }, { 0x119D4, 0x119DB }, { 0x119E0, 0x119E0 },
+    { 0x11A01, 0x11A0A }, { 0x11A33, 0x11A38 }, { 0x11A3B, 0x11A3E }, { 0x11A47, 0x11A47 },
+    { 0x11A51, 0x11A56 }, { 0x11A59, 0x11A5B }, { 0x11A8A, 0x11A96 }, { 0x11A98, 0x11A99 },
+    { 0x11C30, 0x11C3D }, { 0x11C3F, 0x11C3F }, { 0x11C92, 0x11CA7 }, { 0x11CAA, 0x11CB0 },
+    { 0x11CB2, 0x11CB3 }, { 0x11CB5, 0x11CB6 }, { 0x11D31, 0x11D45 }, { 0x11D47, 0x11D47 },
+    { 0x11D90, 0x11D91 }, { 0x11D95, 0x11D95 }, { 0x11D97, 0x11D97 }, { 0x11EF3, 0x11EF4 },
+    { 0x13430, 0x13438 }, { 0x16AF0, 0x16AF4 }, { 0x16B30, 0x16B36 }, { 0x16F4F, 0x16F4F },
+    { 0x16F8F, 0x16F92 }, { 0x16FE4, 0x16FE4 }, { 0x1BC9D, 0x1BC9E }, { 0x1BCA0, 0x1CF46 },
+    { 0x1D167, 0x1D169 }, { 0x1D173, 0x1D182 }, { 0x1D185, 0x1D18B }, { 0x1D1AA, 0x1D1AD },
+    { 0x1D242, 0x1D244 }, { 0x1DA00, 0x1DA36 }, { 0x1DA3B, 0x1DA6C }, { 0x1DA75, 0x1DA75 },
+    { 0x1DA84, 0x1DA84 }, { 0x1DA9B, 0x1DAAF }, { 0x1E000, 0x1E02A }, { 0x1E130, 0x1E136 },
+    { 0x1E2AE, 0x1E2AE }, { 0x1E2EC, 0x1E2EF }, { 0x1E8D0, 0x1E8D6 }, { 0x1E944, 0x1E94A },
+    { 0xE0001, 0xE01EF }
+};
+
+// Code points that take two columns: East Asian Wide and Fullwidth characters
+// (Unicode 14.0, unassigned gaps between ranges are merged)
+static const unicode_range WIDE_RANGES[] = {
+    { 0x1100, 0x115F }, { 0x231A, 0x231B }, { 0x2329, 0x232A }, { 0x23E9, 0x23EC },
+    { 0x23F0, 0x23F0 }, { 0x23F3, 0x23F3 }, { 0x25FD, 0x25FE }, { 0x2614, 0x2615 },
+    { 0x2648, 0x2653 }, { 0x267F, 0x267F }, { 0x2693, 0x2693 }, { 0x26A1, 0x26A1 },
+    { 0x26AA, 0x26AB }, { 0x26BD, 0x26BE }, { 0x26C4, 0x26C5 }, { 0x26CE, 0x26CE },
+    { 0x26D4, 0x26D4 }, { 0x26EA, 0x26EA }, { 0x26F2, 0x26F3 }, { 0x26F5, 0x26F5 },
+    { 0x26FA, 0x26FA }, { 0x26FD, 0x26FD }, { 0x2705, 0x2705 }, { 0x270A, 0x270B },
+    { 0x2728, 0x2728 }, { 0x274C, 0x274C }, { 0x274E, 0x274E }, { 0x2753, 0x2755 },
+    { 0x2757, 0x2757 }, { 0x2795, 0x2797 }, { 0x27B0, 0x27B0 }, { 0x27BF, 0x27BF },
+    { 0x2B1B, 0x2B1C }, { 0x2B50, 0x2B50 }, { 0x2B55, 0x2B55 }, { 0x2E80, 0x3029 },
+    { 0x302E, 0x303E }, { 0x3041, 0x3096 }, { 0x309B, 0x3247 }, { 0x3250, 0x4DBF },
+    { 0x4E00, 0xA4C6 }, { 0xA960, 0xA97C }, { 0xAC00, 0xD7A3 }, { 0xF900, 0xFAD9 },
+    { 0xFE10, 0xFE19 }, { 0xFE30, 0xFE6B }, { 0xFF01, 0xFF60 }, { 0xFFE0, 0xFFE6 },
+    { 0x16FE0, 0x16FE3 }, { 0x16FF0, 0x1B2FB }, { 0x1F004, 0x1F004 }, { 0x1F0CF, 0x1F0CF },
+    { 0x1F18E, 0x1F18E }, { 0x1F191, 0x1F19A }, { 0x1F200, 0x1F320 }, { 0x1F32D, 0x1F335 },
+    { 0x1F337, 0x1F37C }, { 0x1F37E, 0x1F393 }, { 0x1F3A0, 0x1F3CA }, { 0x1F3CF, 0x1F3D3 },
+    { 0x1F3E0, 0x1F3F0 }, { 0x1F3F4, 0x1F3F4 }, { 0x1F3F8, 0x1F43E }, { 0x1F440, 0x1F440 },
+    { 0x1F442, 0x1F4FC }, { 0x1F4FF, 0x1F53D }, { 0x1F54B, 0x1F54E }, { 0x1F550, 0x1F567 },
+    { 0x1F57A, 0x1F57A }, { 0x1F595, 0x1F596 }, { 0x1F5A4, 0x1F5A4 }, { 0x1F5FB, 0x1F64F },
+    { 0x1F680, 0x1F6C5 }, { 0x1F6CC, 0x1F6CC }, { 0x1F6D0, 0x1F6D2 }, { 0x1F6D5, 0x1F6DF },
+    { 0x1F6EB, 0x1F6EC }, { 0x1F6F4, 0x1F6FC }, { 0x1F7E0, 0x1F7F0 }, { 0x1F90C, 0x1F93A },
+    { 0x1F93C, 0x1F945 }, { 0x1F947, 0x1F9FF }, { 0x1FA70, 0x1FAF6 }, { 0x20000, 0x3134A }
+};
+
+/**
+ * @brief Checks whether a code point lies in a sorted table of ranges.
+ *
+ * @param code_point   The code point to look up.
+ * @param ranges       The table, sorted and without overlaps.
+ * @param range_count  Number of ranges in the table.
+ *
+ * @return `true` if a range of the table contains the code point, `false` otherwise.
+ */
+static bool in_unicode_ranges(
+    const uint32_t &code_point,
+    const unicode_range *ranges,
+    const size_t &range_count
+) {
+    if (code_point < ranges[0].first || code_point > ranges[range_count - 1].last) return false;
+
+    size_t range_begin = 0;
+    size_t range_end = range_count;
+
+    while (range_begin < range_end) {
+        size_t range_mid = range_begin + (range_end - range_begin) / 2;
+
+        if (code_point > ranges[range_mid].last) range_begin = range_mid + 1;
+        else if (code_point < ranges[range_mid].first) range_end = range_mid;
+        else return true;
+    }
+
+    return false;
+}
+
+int get_code_point_width(const uint32_t &code_point) {
+    // Nothing below the combining diacritical marks is zero-width or wide
+    if (code_point < 0x300) return 1;
+
+    if (in_unicode_ranges(code_point, ZERO_WIDTH_RANGES, sizeof(ZERO_WIDTH_RANGES) / sizeof(ZERO_WIDTH_RANGES[0]))) return 0;
+    if (in_unicode_ranges(code_point, WIDE_RANGES, sizeof(WIDE_RANGES) / sizeof(WIDE_RANGES[0]))) return 2;
+
+    return 1;
+}
+
+size_t decode_utf8(
+    const char *text,
+    const size_t &text_length,
+    uint32_t &code_point
+) {
+    unsigned char lead_byte = static_cast<unsigned char>(text[0]);
+    size_t sequence_length;
+
+    if (lead_byte >= 0xC2 && lead_byte <= 0xDF) sequence_length = 2, code_point = lead_byte & 0x1F;
+    else if (lead_byte >= 0xE0 && lead_byte <= 0xEF) sequence_length = 3, code_point = lead_byte & 0x0F;
+    else if (lead_byte >= 0xF0 && lead_byte <= 0xF4) sequence_length = 4, code_point = lead_byte & 0x07;
+    else return 0;
+
+    if (sequence_length > text_length) return 0;
+
+    for (size_t index = 1; index < sequence_length; ++index) {
+        unsigned char next_byte = static_cast<unsigned char>(text[index]);
+
+        if ((next_byte & 0xC0) != 0x80) return 0;
+
+        code_point = (code_point << 6) | (next_byte & 0x3F);
+    }
+
+    return sequence_length;
+}
+
+size_t fit_display_width(
+    const string_view &text,
+    const size_t &max_width,
+    size_t &prefix_width
+) {
+    const char *text_begin = text.data();
+    const char *text_end = text_begin + text.length();
+    const char *cursor = text_begin;
+
+    size_t text_width = 0;
+
+    while (cursor < text_end) {
+        // Skip whole words of ASCII bytes
+        while (text_end - cursor >= 8 && max_width - text_width >= 8) {
+            uint64_t word;
+
+            memcpy(&word, cursor, sizeof(word));
+
+            if (word & 0x8080808080808080ULL) break;
+
+            cursor += 8;
+            text_width += 8;
+        }
+
+        if (cursor == text_end) break;
+
+        uint32_t code_point = static_cast<unsigned char>(*cursor);
+        size_t sequence_length = 1;
+
+        if (code_point >= 0x80 && (sequence_length = decode_utf8(cursor, text_end - cursor, code_point)) == 0) {
+            // Invalid bytes take one column each
+            sequence_length = 1;
+            code_point = 0;
+        }
+
+        size_t char_width = code_point >= 0x300 ? get_code_point_width(code_point) : 1;
+
+        if (char_width > max_width - text_width) break;
+
+        cursor += sequence_length;
+        text_width += char_width;
+    }
+
+    prefix_width = text_width;
+
+    return cursor - text_begin;
+}
+
+size_t get_display_width(const string_view &text) {
+    size_t text_width;
+
+    fit_display_width(text, SIZE_MAX, text_width);
+
+    return text_width;
+}
+
+void get_cell_widths(
+    const string_view *tab_row,
+    const size_t &cell_count,
+    vector<size_t> &cell_widths
+) {
+    cell_widths.resize(cell_count);
+
+    for (size_t index = 0; index < cell_count; ++index) cell_widths[index] = get_display_width(tab_row[index]);
+}
+
+cell_number parse_cell_number(const string_view &tab_cell) {
+    cell_number number = { NAN, tab_cell.empty() ? NUMBER_EMPTY : NUMBER_NONE, 0 };
+
+    if (tab_cell.empty()) return number;
+
+    const char *cell_end = tab_cell.data() + tab_cell.length();
+    const char *digits = tab_cell.data() + (tab_cell[0] == '-' || tab_cell[0] == '+');
+
+    // The number must start with a digit, so that from_chars() reads neither "inf" nor "nan"
+    if (digits == cell_end) return number;
+
+    bool leading_point = *digits == '.' && digits + 1 < cell_end && isdigit(static_cast<unsigned char>(digits[1]));
+
+    if (!isdigit(static_cast<unsigned char>(*digits)) && !leading_point) return number;
+
+    double value;
+    from_chars_result parsed = from_chars(digits, cell_end, value);
+
+    if (parsed.ec != errc()) return number;
+
+    bool is_float = false;
+    size_t decimals = 0;
+
+    // Count the digits after the decimal point, an exponent ending them
+    for (const char *cursor = digits; cursor < parsed.ptr; ++cursor) {
+        if (*cursor == 'e' || *cursor == 'E') {
+            is_float = true;
+
+            break;
+        }
+
+        if (is_float) ++decimals;
+        else if (*cursor == '.') is_float = true;
+    }
+
+    string_view suffix(parsed.ptr, cell_end - parsed.ptr);
+    number_kind kind = is_float ? NUMBER_FLOAT : NUMBER_INTEGER;
+
+    if (suffix == "%") kind = NUMBER_PERCENT;
+    else if (!suffix.empty()) {
+        // Only the kilo unit is also known in lowercase ("kB"), "5m" or "2e" are rather text
+        size_t unit_power = SIZE_UNITS.find(suffix[0] == 'k' ? 'K' : suffix[0]);
+
+        // A unit letter, optionally followed by "i", then an optional "B"
+        if (unit_power != string_view::npos) {
+            suffix.remove_prefix(1);
+
+            if (!suffix.empty() && suffix[0] == 'i') suffix.remove_prefix(1);
+
+            value *= pow(1024.0, static_cast<double>(unit_power + 1));
+        }
+
+        if (!suffix.empty() && suffix[0] == 'B') suffix.remove_prefix(1);
+
+        if (!suffix.empty()) return number;
+
+        kind = NUMBER_SIZE;
+    }
+
+    number.value = tab_cell[0] == '-' ? -value : value;
+    number.kind = kind;
+    number.decimals = static_cast<uint8_t>(min(decimals, static_cast<size_t>(UINT8_MAX)));
+
+    return number;
+}
+
+string_view store_bytes(
+    tab_store &store,
+    const string_view &bytes
+) {
+    if (bytes.length() > store.arena_left) {
+        size_t block_size = max(static_cast<size_t>(ARENA_BLOCK_SIZE), bytes.length());
+
+        store.arena_blocks.emplace_back(new char[block_size]);
+        store.arena_cursor = store.arena_blocks.back().get();
+        store.arena_left = block_size;
+    }
+
+    char *copied_bytes = store.arena_cursor;
+
+    if (!bytes.empty()) memcpy(copied_bytes, bytes.data(), bytes.length());
+
+    store.arena_cursor += bytes.length();
+    store.arena_left -= bytes.length();
+
+    return string_view(copied_bytes, bytes.length());
+}
+
+void store_row(
+    tab_store &store,
+    const vector<string_view> &tab_row,
+    const char *stable_begin,
+    const char *stable_end
+) {
+    if (store.row_offsets.empty()) store.row_offsets.push_back(0);
+
+    for (const auto &tab_cell : tab_row) {
+        if (tab_cell.data() >= stable_begin && tab_cell.data() < stable_end) store.cells.push_back(tab_cell);
+        else store.cells.push_back(store_bytes(store, tab_cell));
+
+        store.cell_widths.push_back(get_display_width(tab_cell));
+
+        if (store.parse_numbers) store.cell_numbers.push_back(parse_cell_number(tab_cell));
+    }
+
+    store.row_offsets.push_back(store.cells.size());
+}
+
+void store_replace_row(
+    tab_store &store,
+    const size_t &row_index,
+    const vector<string> &tab_row
+) {
+    size_t row_begin = store.row_offsets[row_index];
+    size_t row_end = store.row_offsets[row_index + 1];
+    vector<string_view> new_cells;
+    vector<size_t> new_cell_widths;
+    vector<cell_number> new_cell_numbers;
+
+    for (const auto &tab_cell : tab_row) {
+        new_cells.push_back(store_bytes(store, tab_cell));
+        new_cell_widths.push_back(get_display_width(tab_cell));
+
+        if (store.parse_numbers) new_cell_numbers.push_back(parse_cell_number(tab_cell));
+    }
+
+    store.cells.erase(store.cells.begin() + row_begin, store.cells.begin() + row_end);
+    store.cells.insert(store.cells.begin() + row_begin, new_cells.begin(), new_cells.end());
+    store.cell_widths.erase(store.cell_widths.begin() + row_begin, store.cell_widths.begin() + row_end);
+    store.cell_widths.insert(store.cell_widths.begin() + row_begin, new_cell_widths.begin(), new_cell_widths.end());
+
+    if (store.parse_numbers) {
+        store.cell_numbers.erase(store.cell_numbers.begin() + row_begin, store.cell_numbers.begin() + row_end);
+        store.cell_numbers.insert(store.cell_numbers.begin() + row_begin, new_cell_numbers.begin(), new_cell_numbers.end());
+    }
+
+    for (size_t index = row_index + 1; index < store.row_offsets.size(); ++index) {
+        store.row_offsets[index] = store.row_offsets[index] - (row_end - row_begin) + new_cells.size();
+    }
+}
+
+size_t store_row_count(const tab_store &store) {
+    return store.row_offsets.empty() ? 0 : store.row_offsets.size() - 1;
+}
+
+void store_clear(tab_store &store) {
+    store.arena_blocks.clear();
+    store.arena_cursor = NULL;
+    store.arena_left = 0;
+    store.cells.clear();
+    store.cell_widths.clear();
+    store.row_offsets.clear();
+    store.cell_numbers.clear();
+}
+
+// Number of table bytes read from the input and written to the outputs, reported by --stats
+atomic<size_t> input_byte_count(0);
+atomic<size_t> output_byte_count(0);
+
+stats_clock stats_now() {
+    struct timespec cpu_time;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_time);
+
+    return { chrono::steady_clock::now(), cpu_time.tv_sec + cpu_time.tv_nsec / 1e9 };
+}
+
+void stats_end_phase(
+    tab_stats &stats,
+    const stats_phase_id &phase
+) {
+    stats_clock phase_end = stats_now();
+
+    stats.wall_seconds[phase] += chrono::duration<double>(phase_end.wall - stats.phase_start.wall).count();
+    stats.cpu_seconds[phase] += phase_end.cpu_seconds - stats.phase_start.cpu_seconds;
+    stats.phase_start = phase_end;
+}
+
+/**
+ * @brief Counts one table row in the run statistics.
+ *
+ * @param stats       The run statistics.
+ * @param cell_count  Number of cells in the row.
+ */
+inline void stats_count_row(
+    tab_stats &stats,
+    const size_t &cell_count
+) {
+    ++stats.row_count;
+    stats.cell_count += cell_count;
+    stats.max_col_count = max(stats.max_col_count, cell_count);
+}
+
+ssize_t read_block(
+    const int &file_descriptor,
+    char *buffer,
+    const size_t &buffer_size
+) {
+    ssize_t bytes_read;
+
+    do bytes_read = read(file_descriptor, buffer, buffer_size);
+    while (bytes_read < 0 && errno == EINTR);
+
+    return bytes_read;
+}
+
+bool write_block(
+    const int &file_descriptor,
+    const char *buffer,
+    size_t buffer_size
+) {
+    while (buffer_size > 0) {
+        ssize_t bytes_written = write(file_descriptor, buffer, buffer_size);
+
+        if (bytes_written < 0) {
+            if (errno == EINTR) continue;
+
+            return false;
+        }
+
+        buffer += bytes_written;
+        buffer_size -= bytes_written;
+    }
+
+    return true;
+}
+
+// --------------------------------------------------
+// I/O Pipeline
+// --------------------------------------------------
+
+// Positions in a lock-free single-producer single-consumer ring of PIPELINE_QUEUE_SLOTS slots
+typedef struct spsc_ring {
+    alignas(64) atomic<size_t> head;  // Slots released so far, written only by the consumer
+    alignas(64) atomic<size_t> tail;  // Slots published so far, written only by the producer
+} spsc_ring;
+
+// Raw input block struct, filled by the reader thread
+typedef struct read_slot {
+    unique_ptr<char[]> bytes;  // READ_BLOCK_SIZE bytes, allocated on first use
+    size_t length;             // Number of bytes read into the block
+} read_slot;
+
+// Reader, renderer and writer stage struct
+typedef struct io_pipeline {
+    int input_fd;                                   // Descriptor drained by the reader thread
+    int output_fd;                                  // Descriptor written by the writer thread
+    read_slot input_slots[PIPELINE_QUEUE_SLOTS];    // Raw blocks handed from the reader to the renderer
+    string output_slots[PIPELINE_QUEUE_SLOTS];      // Rendered bytes handed from the renderer to the writer
+    spsc_ring input_ring;
+    spsc_ring output_ring;
+    bool holding_input;                             // Whether the renderer still parses the head input slot
+    atomic<bool> input_ended;                       // Set by the reader after its last block
+    atomic<bool> output_ended;                      // Set by the renderer after its last flush
+    atomic<bool> stopping;                          // Set by the renderer to stop the reader early
+    atomic<int> sleeper_count;                      // Number of stages waiting on `stage_changed`
+    mutex stage_mutex;
+    condition_variable stage_changed;               // Wakes the stages sleeping on an empty or full ring
+    thread reader_thread;
+    thread writer_thread;
+} io_pipeline;
+
+static inline bool ring_empty(const spsc_ring &ring) {
+    return ring.head.load(memory_order_acquire) == ring.tail.load(memory_order_acquire);
+}
+
+static inline bool ring_full(const spsc_ring &ring) {
+    return ring.tail.load(memory_order_acquire) - ring.head.load(memory_order_acquire) == PIPELINE_QUEUE_SLOTS;
+}
+
+/**
+ * @brief Wakes the stages sleeping on the pipeline after a slot was published or released.
+ *
+ * The mutex is only taken when a stage sleeps, so the rings stay lock-free while every stage
+ * keeps up. The fence pairs with the one in `pipeline_wait()`: either the sleeper is counted
+ * here, or the sleeper sees the ring change and does not sleep.
+ *
+ * @param pipeline  The pipeline whose ring changed.
+ */
+static void pipeline_notify(io_pipeline &pipeline) {
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (pipeline.sleeper_count.load(memory_order_relaxed) == 0) return;
+
+    {
+        lock_guard<mutex> lock(pipeline.stage_mutex);
+    }
+
+    pipeline.stage_changed.notify_all();
+}
+
+/**
+ * @brief Sleeps until a stage can make progress.
+ *
+ * @param pipeline    The pipeline.
+ * @param ready       Checks whether the stage can make progress.
+ * @param timeout_ms  Milliseconds to wait at most, or -1 to wait until ready.
+ *
+ * @return Whether the stage is ready, false only on timeout.
+ */
+static bool pipeline_wait(
+    io_pipeline &pipeline,
+    const function<bool()> &ready,
+    const int &timeout_ms = -1
+) {
+    if (ready()) return true;
+
+    unique_lock<mutex> lock(pipeline.stage_mutex);
+
+    pipeline.sleeper_count.fetch_add(1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (timeout_ms < 0) pipeline.stage_changed.wait(lock, ready);
+    else pipeline.stage_changed.wait_for(lock, chrono::milliseconds(timeout_ms), ready);
+
+    pipeline.sleeper_count.fetch_sub(1, memory_order_relaxed);
+
+    return ready();
+}
+
+// Reader thread, draining the input descriptor into the input ring
+static void read_pipeline_input(io_pipeline &pipeline) {
+    while (pipeline_wait(pipeline, [&]() { return !ring_full(pipeline.input_ring) || pipeline.stopping.load(memory_order_acquire); }) && !pipeline.stopping.load(memory_order_acquire)) {
+        size_t tail = pipeline.input_ring.tail.load(memory_order_relaxed);
+        read_slot &slot = pipeline.input_slots[tail % PIPELINE_QUEUE_SLOTS];
+
+        if (!slot.bytes) slot.bytes.reset(new char[READ_BLOCK_SIZE]);
+
+        ssize_t block_length = read_block(pipeline.input_fd, slot.bytes.get(), READ_BLOCK_SIZE);
+
+        if (block_length <= 0) break;
+
+        slot.length = block_length;
+        pipeline.input_ring.tail.store(tail + 1, memory_order_release);
+
+        pipeline_notify(pipeline);
+    }
+
+    pipeline.input_ended.store(true, memory_order_release);
+
+    pipeline_notify(pipeline);
+}
+
+// Writer thread, draining the output ring into the output descriptor
+static void write_pipeline_output(io_pipeline &pipeline) {
+    while (true) {
+        pipeline_wait(pipeline, [&]() { return !ring_empty(pipeline.output_ring) || pipeline.output_ended.load(memory_order_acquire); });
+
+        // The last flush is published before the end is set, so an empty ring is final only after the end
+        if (ring_empty(pipeline.output_ring)) {
+            if (pipeline.output_ended.load(memory_order_acquire) && ring_empty(pipeline.output_ring)) return;
+
+            continue;
+        }
+
+        size_t head = pipeline.output_ring.head.load(memory_order_relaxed);
+        string &slot = pipeline.output_slots[head % PIPELINE_QUEUE_SLOTS];
+
+        write_block(pipeline.output_fd, slot.data(), slot.size());
+
+        slot.clear();
+        pipeline.output_ring.head.store(head + 1, memory_order_release);
+
+        pipeline_notify(pipeline);
+    }
+}
+
+/**
+ * @brief Starts the reader and writer threads around the calling renderer thread.
+ *
+ * @param pipeline   The pipeline, value-initialized by the caller.
+ * @param input_fd   The descriptor drained by the reader thread.
+ * @param output_fd  The descriptor written by the writer thread.
+ */
+static void pipeline_start(
+    io_pipeline &pipeline,
+    const int &input_fd,
+    const int &output_fd
+) {
+    pipeline.input_fd = input_fd;
+    pipeline.output_fd = output_fd;
+
+    pipeline.reader_thread = thread(read_pipeline_input, ref(pipeline));
+    pipeline.writer_thread = thread(write_pipeline_output, ref(pipeline));
+}
+
+/**
+ * @brief Takes the next raw input block from the reader thread.
+ *
+ * The previous block is released first, so a block stays valid until the next call. While
+ * waiting, output held back by a busy writer thread is handed over as soon as a slot frees.
+ *
+ * @param pipeline    The pipeline.
+ * @param output      The renderer output writer, flushed into the pipeline.
+ * @param block       Receives the start of the block.
+ * @param timeout_ms  Milliseconds to wait at most for input, or -1 to wait until it arrives.
+ *
+ * @return The number of bytes in the block, 0 on end of input, or -1 on timeout.
+ */
+static ssize_t pipeline_read(
+    io_pipeline &pipeline,
+    out_buffer &output,
+    const char *&block,
+    const int &timeout_ms = -1
+) {
+    spsc_ring &ring = pipeline.input_ring;
+
+    if (pipeline.holding_input) {
+        ring.head.store(ring.head.load(memory_order_relaxed) + 1, memory_order_release);
+        pipeline.holding_input = false;
+
+        pipeline_notify(pipeline);
+    }
+
+    auto input_ready = [&]() { return !ring_empty(ring) || pipeline.input_ended.load(memory_order_acquire); };
+    auto output_ready = [&]() { return !output.data.empty() && !ring_full(pipeline.output_ring); };
+
+    while (!input_ready()) {
+        if (!pipeline_wait(pipeline, [&]() { return input_ready() || output_ready(); }, timeout_ms)) return -1;
+
+        if (output_ready()) out_flush(output);
+    }
+
+    // The last block is published before the end is set, so an empty ring is final only after the end
+    if (ring_empty(ring)) return 0;
+
+    const read_slot &slot = pipeline.input_slots[ring.head.load(memory_order_relaxed) % PIPELINE_QUEUE_SLOTS];
+
+    pipeline.holding_input = true;
+    block = slot.bytes.get();
+
+    return slot.length;
+}
+
+/**
+ * @brief Hands the collected output to the writer thread.
+ *
+ * The bytes are swapped into a free slot, so the writer gets them without a copy and the
+ * renderer gets back the capacity of a drained slot. When every slot is taken, the output keeps
+ * collecting, so a blocked stdout does not stall the input, until `PIPELINE_BACKLOG_LIMIT`.
+ *
+ * @param pipeline  The pipeline.
+ * @param output    The renderer output writer.
+ */
+static void pipeline_write(
+    io_pipeline &pipeline,
+    out_buffer &output
+) {
+    spsc_ring &ring = pipeline.output_ring;
+
+    if (output.data.empty()) return;
+
+    if (ring_full(ring)) {
+        if (output.data.size() < PIPELINE_BACKLOG_LIMIT) return;
+
+        pipeline_wait(pipeline, [&]() { return !ring_full(ring); });
+    }
+
+    size_t tail = ring.tail.load(memory_order_relaxed);
+
+    output_byte_count.fetch_add(output.data.size(), memory_order_relaxed);
+
+    pipeline.output_slots[tail % PIPELINE_QUEUE_SLOTS].swap(output.data);
+    ring.tail.store(tail + 1, memory_order_release);
+
+    pipeline_notify(pipeline);
+}
+
+/**
+ * @brief Hands over the last output, then joins the reader and writer threads.
+ *
+ * A reader still blocked on its input is joined once that read returns.
+ *
+ * @param pipeline  The pipeline.
+ * @param output    The renderer output writer, emptied and detached from the pipeline.
+ */
+static void pipeline_finish(
+    io_pipeline &pipeline,
+    out_buffer &output
+) {
+    while (!output.data.empty()) {
+        pipeline_wait(pipeline, [&]() { return !ring_full(pipeline.output_ring); });
+        pipeline_write(pipeline, output);
+    }
+
+    output.pipeline = NULL;
+
+    pipeline.output_ended.store(true, memory_order_release);
+    pipeline.stopping.store(true, memory_order_release);
+
+    pipeline_notify(pipeline);
+
+    pipeline.writer_thread.join();
+    pipeline.reader_thread.join();
+}
+
+void out_flush(out_buffer &output) {
+    if (output.pipeline != NULL) {
+        pipeline_write(*output.pipeline, output);
+
+        return;
+    }
+
+    if (!output.data.empty()) write_block(output.file_descriptor, output.data.data(), output.data.size());
+
+    output_byte_count.fetch_add(output.data.size(), memory_order_relaxed);
+
+    output.data.clear();
+}
+
+fill_pattern make_fill_pattern(
+    const string_view &glyph,
+    const size_t &max_glyph_count
+) {
+    fill_pattern pattern;
+
+    pattern.glyph_length = min(glyph.length(), static_cast<size_t>(FILL_BLOCK_SIZE));
+    pattern.block_length = 0;
+
+    if (pattern.glyph_length == 0) return pattern;
+
+    size_t whole_length = min(FILL_BLOCK_SIZE / pattern.glyph_length, max(max_glyph_count, static_cast<size_t>(1))) * pattern.glyph_length;
+
+    memcpy(pattern.block, glyph.data(), pattern.glyph_length);
+
+    // Double the filled prefix until the block holds every whole copy of the glyph
+    for (pattern.block_length = pattern.glyph_length; pattern.block_length < whole_length; pattern.block_length += min(pattern.block_length, whole_length - pattern.block_length)) {
+        memcpy(pattern.block + pattern.block_length, pattern.block, min(pattern.block_length, whole_length - pattern.block_length));
+    }
+
+    return pattern;
+}
+
+pair<size_t, string> align_text(
+    string_view string_to_align,
+    size_t tab_col_width,
+    string text_alignment
+) {
+    size_t string_length = get_display_width(string_to_align);
+
+    // Calculate the total padding required
+    size_t col_total_padding = tab_col_width > string_length ? tab_col_width - string_length : 0;
+
+    // Leading spaces: all of them for right alignment, half for center alignment, none by default
+    size_t col_left_padding = (
+        text_alignment == ALIGN_RIGHT ? col_total_padding : 
+        text_alignment == ALIGN_CENTER ? col_total_padding / 2 : 
+        0
+    );
+
+    // Build the aligned string in one allocation
+    string result;
+
+    result.reserve(string_to_align.length() + col_total_padding);
+    result.append(col_left_padding, SPACE);
+    result.append(string_to_align.data(), string_to_align.length());
+    result.append(col_total_padding - col_left_padding, SPACE);
+
+    return { tab_col_width, result };
+}
+
+text_alignment get_text_alignment(const string &text_align) {
+    if (text_align == ALIGN_CENTER) return TEXT_ALIGN_CENTER;
+    else if (text_align == ALIGN_RIGHT) return TEXT_ALIGN_RIGHT;
+
+    return TEXT_ALIGN_LEFT;
+}
+
+size_t get_terminal_width() {
+    struct winsize window_size;
+
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &window_size) == 0 && window_size.ws_col > 0) return window_size.ws_col;
+
+    const char *columns = getenv("COLUMNS");
+
+    return columns != NULL ? strtoul(columns, NULL, 10) : 0;
+}
+
+void clamp_col_widths(
+    vector<size_t> &col_content_width,
+    const size_t &max_col_width,
+    const size_t &max_table_width,
+    const int &col_padding,
+    const bool &use_border
+) {
+    size_t col_count = col_content_width.size();
+
+    if (max_col_width > 0) {
+        for (auto& col_width : col_content_width) col_width = min(col_width, max_col_width);
+    }
+
+    if (max_table_width == 0 || col_count == 0) return;
+
+    // Bytes of every row that are not cell content: padding and vertical lines
+    size_t fixed_width = col_count * col_padding + (use_border ? col_count + 1 : 0);
+    size_t content_budget = max_table_width > fixed_width ? max_table_width - fixed_width : 0;
+    size_t content_width = 0;
+
+    for (const auto &col_width : col_content_width) content_width += col_width;
+
+    if (content_width <= content_budget) return;
+
+    // Binary search the largest common cap that fits, columns narrower than it keep their width
+    auto capped_width = [&](const size_t &width_cap) {
+        size_t total_width = 0;
+
+        for (const auto &col_width : col_content_width) total_width += min(col_width, width_cap);
+
+        return total_width;
+    };
+
+    size_t width_cap = 0;
+    size_t cap_limit = *max_element(col_content_width.begin(), col_content_width.end());
+
+    while (width_cap < cap_limit) {
+        size_t middle_cap = width_cap + (cap_limit - width_cap + 1) / 2;
+
+        if (capped_width(middle_cap) <= content_budget) width_cap = middle_cap;
+        else cap_limit = middle_cap - 1;
+    }
+
+    width_cap = max<size_t>(width_cap, 1);
+
+    for (auto& col_width : col_content_width) col_width = min(col_width, width_cap);
+}
+
+fit_layout choose_fit_layout(
+    const vector<size_t> &col_content_width,
+    const size_t &max_table_width,
+    const int &col_padding,
+    const bool &use_border
+) {
+    size_t col_count = col_content_width.size();
+
+    if (max_table_width == 0 || col_count == 0) return FIT_NONE;
+
+    // Bytes of every row that are not cell content: padding and vertical lines
+    size_t fixed_width = col_count * col_padding + (use_border ? col_count + 1 : 0);
+    size_t content_budget = max_table_width > fixed_width ? max_table_width - fixed_width : 0;
+    size_t content_width = 0;
+
+    for (const auto &col_width : col_content_width) content_width += col_width;
+
+    if (content_width <= content_budget) return FIT_NONE;
+
+    if ((content_width - content_budget) * FIT_SHRINK_LOSS <= content_width) return FIT_SHRINK;
+
+    // Wrapping needs room for the narrow columns whole and for a few characters of each wide one
+    size_t wrap_width = 0;
+
+    for (const auto &col_width : col_content_width) wrap_width += min<size_t>(col_width, FIT_WRAP_MIN_WIDTH);
+
+    if (wrap_width <= content_budget) return FIT_WRAP;
+
+    return FIT_STACK;
+}
+
+void get_stack_sections(
+    const vector<size_t> &col_content_width,
+    const size_t &max_table_width,
+    const int &col_padding,
+    const bool &use_border,
+    vector<vector<size_t>> &sections
+) {
+    size_t col_count = col_content_width.size();
+    size_t border_width = use_border ? 1 : 0;
+
+    auto col_total_width = [&](const size_t &col_index) { return col_content_width[col_index] + col_padding + border_width; };
+
+    bool repeat_first_col = col_count > 1 && max_table_width > 0 && col_total_width(0) * 3 <= max_table_width;
+
+    sections.assign(1, {});
+
+    size_t section_width = border_width;
+
+    for (size_t index = 0; index < col_count; ++index) {
+        // Start a new section once the column does not fit, opening it with the first column
+        if (max_table_width > 0 && !sections.back().empty() && section_width + col_total_width(index) > max_table_width) {
+            sections.emplace_back();
+            section_width = border_width;
+
+            if (repeat_first_col) {
+                sections.back().push_back(0);
+                section_width += col_total_width(0);
+            }
+        }
+
+        sections.back().push_back(index);
+        section_width += col_total_width(index);
+    }
+}
+
+/**
+ * @brief Renders a body line whose cells fit their columns, for one combination of plan features.
+ *
+ * The exact length of the line is known from the cell lengths and widths, so the line is
+ * sized once and copied into place with memcpy and memset. No feature of the plan is tested
+ * per cell, and a flush is only considered once the whole line is written.
+ *
+ * @tparam use_row_prefix   Whether the rows open with a left border.
+ * @tparam use_cell_prefix  Whether the body cells open with style sequences.
+ * @tparam col_align        The alignment shared by every body column.
+ *
+ * @param output       The output writer receiving the line.
+ * @param tab_row      The cells of the line.
+ * @param cell_widths  The display width of each cell of the line.
+ * @param cell_count   Number of cells in the line.
+ * @param plan         The compiled render plan.
+ *
+ * @return `false` if a cell is wider than its column, nothing being written, `true` otherwise.
+ */
+template <bool use_row_prefix, bool use_cell_prefix, text_alignment col_align>
+static bool render_body_line(
+    out_buffer &output,
+    const string_view *tab_row,
+    const size_t *cell_widths,
+    const size_t &cell_count,
+    const render_plan &plan
+) {
+    size_t col_count = plan.max_col_count;
+    size_t filled_count = min(cell_count, col_count);
+    size_t line_length = plan.body_line_bytes;
+
+    // Every cell byte beyond its display width lengthens the line, as the padding is counted in columns
+    for (size_t index = 0; index < filled_count; ++index) {
+        if (cell_widths[index] > plan.col_content_width[index]) return false;
+
+        line_length += tab_row[index].length() - cell_widths[index];
+    }
+
+    string &data = output.data;
+    size_t line_begin = data.size();
+
+    data.resize(line_begin + line_length);
+
+    char *line = &data[line_begin];
+
+    if (use_row_prefix) {
+        memcpy(line, plan.row_prefix.data(), plan.row_prefix.size());
+        line += plan.row_prefix.size();
+    }
+
+    for (size_t index = 0; index < col_count; ++index) {
+        string_view tab_cell = index < filled_count ? tab_row[index] : "";
+
+        size_t col_total_padding = plan.col_width[index] - (index < filled_count ? cell_widths[index] : 0);
+        size_t col_left_padding = col_align == TEXT_ALIGN_RIGHT ? col_total_padding : col_align == TEXT_ALIGN_CENTER ? col_total_padding / 2 : 0;
+
+        if (use_cell_prefix) {
+            memcpy(line, plan.body_cell_prefix.data(), plan.body_cell_prefix.size());
+            line += plan.body_cell_prefix.size();
+        }
+
+        if (col_align != TEXT_ALIGN_LEFT) {
+            memset(line, SPACE, col_left_padding);
+            line += col_left_padding;
+        }
+
+        memcpy(line, tab_cell.data(), tab_cell.length());
+        line += tab_cell.length();
+
+        memset(line, SPACE, col_total_padding - col_left_padding);
+        line += col_total_padding - col_left_padding;
+
+        memcpy(line, plan.cell_suffix.data(), plan.cell_suffix.size());
+        line += plan.cell_suffix.size();
+    }
+
+    *line = NEWLINE;
+
+    if (data.size() >= WRITE_BUFFER_SIZE && output.file_descriptor >= 0) out_flush(output);
+
+    return true;
+}
+
+/**
+ * @brief Picks the body line kernel of a plan, once its strings and alignments are final.
+ *
+ * @param plan  The compiled render plan.
+ */
+static void select_line_kernel(render_plan &plan) {
+    // Kernels by left border, cell styles and shared alignment
+    static constexpr line_kernel LINE_KERNELS[2][2][3] = {
+        {
+            { render_body_line<false, false, TEXT_ALIGN_LEFT>, render_body_line<false, false, TEXT_ALIGN_CENTER>, render_body_line<false, false, TEXT_ALIGN_RIGHT> },
+            { render_body_line<false, true, TEXT_ALIGN_LEFT>, render_body_line<false, true, TEXT_ALIGN_CENTER>, render_body_line<false, true, TEXT_ALIGN_RIGHT> }
+        },
+        {
+            { render_body_line<true, false, TEXT_ALIGN_LEFT>, render_body_line<true, false, TEXT_ALIGN_CENTER>, render_body_line<true, false, TEXT_ALIGN_RIGHT> },
+            { render_body_line<true, true, TEXT_ALIGN_LEFT>, render_body_line<true, true, TEXT_ALIGN_CENTER>, render_body_line<true, true, TEXT_ALIGN_RIGHT> }
+        }
+    };
+
+    const vector<text_alignment> &col_align = plan.body_col_align;
+
+    bool shared_align = !col_align.empty() && count(col_align.begin(), col_align.end(), col_align[0]) == static_cast<ptrdiff_t>(col_align.size());
+
+    plan.body_line_kernel = shared_align ? LINE_KERNELS[!plan.row_prefix.empty()][!plan.body_cell_prefix.empty()][col_align[0]] : NULL;
+    plan.body_line_bytes = plan.row_prefix.size() + plan.max_col_count * (plan.body_cell_prefix.size() + plan.cell_suffix.size()) + 1;
+
+    for (const auto &col_width : plan.col_width) plan.body_line_bytes += col_width;
+}
+
+render_plan compile_render_plan(
+    const tab_render_options &render_options,
+    const vector<size_t> &col_content_width,
+    const int &col_padding
+) {
+    render_plan plan;
+
+    plan.options = &render_options;
+    plan.wrap_cells = false;
+    plan.max_col_count = col_content_width.size();
+    plan.col_content_width = col_content_width;
+    plan.col_width = col_content_width;
+
+    // Add padding to each column width for spacing
+    for (auto& col_width : plan.col_width) col_width += col_padding;
+
+    plan.header_col_align.assign(plan.max_col_count, get_text_alignment(render_options.header_text_align));
+    plan.body_col_align.assign(plan.max_col_count, get_text_alignment(render_options.body_text_align));
+
+    // Left vertical border, if borders are enabled
+    if (render_options.use_border) {
+        plan.row_prefix = render_options.table_color;
+        plan.row_prefix += render_options.border_style.vertical_line;
+        plan.row_prefix += DEFAULT;
+    }
+
+    plan.header_cell_prefix = render_options.header_text_style + render_options.header_bg_color + render_options.header_text_color;
+    plan.body_cell_prefix = render_options.body_text_style + render_options.body_bg_color + render_options.body_text_color;
+    plan.cell_suffix = DEFAULT + render_options.table_color;
+
+    if (render_options.use_border) plan.cell_suffix += render_options.border_style.vertical_line;
+
+    // Render the horizontal border lines for the final column widths
+    if (render_options.use_border) {
+        const tab_border &tab_border_style = render_options.border_style;
+
+        plan.top_border = get_tab_border(
+            plan.max_col_count, 
+            plan.col_width, 
+            tab_border_style.top.left_char_unicode, 
+            tab_border_style.top.mid_char_unicode, 
+            tab_border_style.top.right_char_unicode, 
+            tab_border_style.top.fill_char_unicode,
+            render_options.table_color
+        );
+        plan.separator_border = get_tab_border(
+            plan.max_col_count, 
+            plan.col_width, 
+            tab_border_style.separator.left_char_unicode, 
+            tab_border_style.separator.mid_char_unicode, 
+            tab_border_style.separator.right_char_unicode, 
+            tab_border_style.separator.fill_char_unicode,
+            render_options.table_color
+        );
+        plan.bottom_border = get_tab_border(
+            plan.max_col_count, 
+            plan.col_width, 
+            tab_border_style.bottom.left_char_unicode, 
+            tab_border_style.bottom.mid_char_unicode, 
+            tab_border_style.bottom.right_char_unicode, 
+            tab_border_style.bottom.fill_char_unicode,
+            render_options.table_color
+        );
+    }
+
+    select_line_kernel(plan);
+
+    return plan;
+}
+
+void read_all(
+    const int &file_descriptor,
+    vector<char> &input
+) {
+    size_t input_length = 0;
+    ssize_t block_length;
+
+    do {
+        input.resize(input_length + READ_BLOCK_SIZE);
+
+        block_length = read_block(file_descriptor, input.data() + input_length, READ_BLOCK_SIZE);
+
+        if (block_length > 0) input_length += block_length;
+    } while (block_length > 0);
+
+    input.resize(input_length);
+
+    input_byte_count.fetch_add(input_length, memory_order_relaxed);
+}
+
+const char *map_input(
+    const int &file_descriptor,
+    size_t &mapping_length
+) {
+    struct stat input_stat;
+
+    mapping_length = 0;
+
+    if (fstat(file_descriptor, &input_stat) != 0 || !S_ISREG(input_stat.st_mode) || input_stat.st_size <= 0) return NULL;
+
+    // Map from the current offset (page aligned) so a partially consumed stdin is honoured
+    off_t input_offset = lseek(file_descriptor, 0, SEEK_CUR);
+    off_t page_size = sysconf(_SC_PAGESIZE);
+
+    if (input_offset < 0 || input_offset >= input_stat.st_size) return NULL;
+
+    off_t mapping_offset = input_offset - input_offset % page_size;
+    size_t full_length = input_stat.st_size - mapping_offset;
+
+    void *mapping = mmap(NULL, full_length, PROT_READ, MAP_PRIVATE, file_descriptor, mapping_offset);
+
+    if (mapping == MAP_FAILED) return NULL;
+
+    madvise(mapping, full_length, MADV_SEQUENTIAL);
+
+    mapping_length = input_stat.st_size - input_offset;
+
+    return static_cast<const char *>(mapping) + (input_offset - mapping_offset);
+}
+
+void unmap_input(
+    const char *mapping,
+    const size_t &mapping_length
+) {
+    if (mapping == NULL) return;
+
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    size_t page_offset = reinterpret_cast<uintptr_t>(mapping) % page_size;
+
+    munmap(const_cast<char *>(mapping - page_offset), mapping_length + page_offset);
+}
+
+input_compression detect_compression(const int &file_descriptor) {
+    struct stat input_stat;
+    unsigned char magic[4];
+
+    if (fstat(file_descriptor, &input_stat) != 0 || !S_ISREG(input_stat.st_mode)) return COMPRESSION_NONE;
+
+    off_t input_offset = lseek(file_descriptor, 0, SEEK_CUR);
+
+    if (input_offset < 0 || pread(file_descriptor, magic, sizeof(magic), input_offset) != static_cast<ssize_t>(sizeof(magic))) return COMPRESSION_NONE;
+
+    if (magic[0] == 0x1f && magic[1] == 0x8b) return COMPRESSION_GZIP;
+    else if (magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) return COMPRESSION_ZSTD;
+
+    return COMPRESSION_NONE;
+}
+
+// Streaming decoder state struct
+typedef struct input_decoder {
+    int file_descriptor;              // The compressed input descriptor
+    input_compression compression;    // The compression format of the input
+    unique_ptr<char[]> input_block;   // Compressed bytes read from the input
+    size_t input_length;              // Number of compressed bytes held by input_block
+    size_t input_offset;              // Number of compressed bytes of input_block already decoded
+    bool input_done;                  // Whether the input reached its end
+    bool stream_ended;                // Whether the last gzip member or zstd frame is complete
+    string error;                     // Why decoding failed, empty while it succeeds
+#ifdef TABSTIJL_ZLIB
+    z_stream gzip_stream;             // The zlib inflate state
+#endif
+#ifdef TABSTIJL_ZSTD
+    ZSTD_DStream *zstd_stream;        // The zstd decompression state
+#endif
+} input_decoder;
+
+/**
+ * @brief Sets up the decompression state of a decoder.
+ *
+ * @param decoder  The decoder, its descriptor and compression being set.
+ *
+ * @return `false` if the compression format was not built in or cannot be set up.
+ */
+static bool open_decoder(input_decoder &decoder) {
+    decoder.input_block.reset(new char[READ_BLOCK_SIZE]);
+    decoder.input_length = 0;
+    decoder.input_offset = 0;
+    decoder.input_done = false;
+    decoder.stream_ended = false;
+
+#ifdef TABSTIJL_ZLIB
+    if (decoder.compression == COMPRESSION_GZIP) {
+        decoder.gzip_stream = {};
+
+        // 15 window bits plus 32 accept both the gzip and the zlib header
+        if (inflateInit2(&decoder.gzip_stream, 15 + 32) == Z_OK) return true;
+
+        decoder.error = "zlib could not be initialized";
+
+        return false;
+    }
+#endif
+
+#ifdef TABSTIJL_ZSTD
+    if (decoder.compression == COMPRESSION_ZSTD) {
+        if ((decoder.zstd_stream = ZSTD_createDStream()) != NULL) return true;
+
+        decoder.error = "zstd could not be initialized";
+
+        return false;
+    }
+#endif
+
+    decoder.error = decoder.compression == COMPRESSION_GZIP ? "gzip support was not built in (TABSTIJL_ZLIB)" : "zstd support was not built in (TABSTIJL_ZSTD)";
+
+    return false;
+}
+
+/**
+ * @brief Releases the decompression state of a decoder set up by `open_decoder()`.
+ *
+ * @param decoder  The decoder.
+ */
+static void close_decoder([[maybe_unused]] input_decoder &decoder) {
+#ifdef TABSTIJL_ZLIB
+    if (decoder.compression == COMPRESSION_GZIP) inflateEnd(&decoder.gzip_stream);
+#endif
+
+#ifdef TABSTIJL_ZSTD
+    if (decoder.compression == COMPRESSION_ZSTD) ZSTD_freeDStream(decoder.zstd_stream);
+#endif
+}
+
+/**
+ * @brief Decompresses the next bytes of the input into a buffer.
+ *
+ * @param decoder   The decoder.
+ * @param buffer    Buffer receiving the decompressed bytes.
+ * @param capacity  Size of the buffer.
+ *
+ * @return Number of decompressed bytes, less than `capacity` only at the end of the input,
+ *         0 once the input is exhausted or `decoder.error` is set.
+ */
+static size_t fill_decoder(
+    input_decoder &decoder,
+    [[maybe_unused]] char *buffer,
+    const size_t &capacity
+) {
+    size_t produced = 0;
+
+    while (produced < capacity && decoder.error.empty()) {
+        // Read the next compressed block once the current one is consumed
+        if (decoder.input_offset == decoder.input_length && !decoder.input_done) {
+            ssize_t block_length = read_block(decoder.file_descriptor, decoder.input_block.get(), READ_BLOCK_SIZE);
+
+            decoder.input_length = block_length > 0 ? block_length : 0;
+            decoder.input_offset = 0;
+            decoder.input_done = block_length <= 0;
+
+            if (block_length < 0) decoder.error = strerror(errno);
+        }
+
+        [[maybe_unused]] size_t input_left = decoder.input_length - decoder.input_offset;
+        size_t step_input = 0, step_output = 0;
+
+#ifdef TABSTIJL_ZLIB
+        if (decoder.compression == COMPRESSION_GZIP) {
+            z_stream &gzip_stream = decoder.gzip_stream;
+
+            gzip_stream.next_in = reinterpret_cast<Bytef *>(decoder.input_block.get() + decoder.input_offset);
+            gzip_stream.avail_in = input_left;
+            gzip_stream.next_out = reinterpret_cast<Bytef *>(buffer + produced);
+            gzip_stream.avail_out = capacity - produced;
+
+            int status = inflate(&gzip_stream, Z_NO_FLUSH);
+
+            step_input = input_left - gzip_stream.avail_in;
+            step_output = capacity - produced - gzip_stream.avail_out;
+
+            if (step_input > 0) decoder.stream_ended = false;
+
+            // A member ended, another one may follow
+            if (status == Z_STREAM_END) {
+                decoder.stream_ended = true;
+
+                inflateReset(&gzip_stream);
+            }
+            else if (status != Z_OK && status != Z_BUF_ERROR) decoder.error = gzip_stream.msg != NULL ? gzip_stream.msg : "corrupt gzip data";
+        }
+#endif
+
+#ifdef TABSTIJL_ZSTD
+        if (decoder.compression == COMPRESSION_ZSTD) {
+            ZSTD_inBuffer zstd_input = { decoder.input_block.get() + decoder.input_offset, input_left, 0 };
+            ZSTD_outBuffer zstd_output = { buffer + produced, capacity - produced, 0 };
+
+            size_t status = ZSTD_decompressStream(decoder.zstd_stream, &zstd_output, &zstd_input);
+
+            step_input = zstd_input.pos;
+            step_output = zstd_output.pos;
+
+            // A frame ended when nothing is left to flush, another one may follow
+            if (ZSTD_isError(status)) decoder.error = ZSTD_getErrorName(status);
+            else if (step_input > 0 || step_output > 0) decoder.stream_ended = status == 0;
+        }
+#endif
+
+        decoder.input_offset += step_input;
+        produced += step_output;
+
+        // Nothing more can come out of an exhausted input
+        if (decoder.input_done && step_input == 0 && step_output == 0) {
+            if (!decoder.stream_ended && decoder.error.empty()) decoder.error = "unexpected end of the compressed input";
+
+            break;
+        }
+    }
+
+    return decoder.error.empty() ? produced : 0;
+}
+
+bool decode_input(
+    const int &file_descriptor,
+    const input_compression &compression,
+    const function<bool(const char *, size_t)> &on_block,
+    const bool &use_thread,
+    string &error
+) {
+    input_decoder decoder;
+
+    decoder.file_descriptor = file_descriptor;
+    decoder.compression = compression;
+
+    if (open_decoder(decoder)) {
+        if (!use_thread) {
+            unique_ptr<char[]> output_block(new char[READ_BLOCK_SIZE]);
+            size_t block_length;
+
+            while ((block_length = fill_decoder(decoder, output_block.get(), READ_BLOCK_SIZE)) > 0 && on_block(output_block.get(), block_length));
+        }
+        else {
+            // Double buffer, the decoder filling one block while the caller consumes the other
+            unique_ptr<char[]> output_blocks[2] = { unique_ptr<char[]>(new char[READ_BLOCK_SIZE]), unique_ptr<char[]>(new char[READ_BLOCK_SIZE]) };
+            size_t block_lengths[2] = { 0, 0 };
+            bool block_ready[2] = { false, false };
+            bool stopped = false;
+
+            mutex block_mutex;
+            condition_variable block_changed;
+
+            thread decoder_thread([&]() {
+                for (size_t slot = 0;; slot ^= 1) {
+                    {
+                        unique_lock<mutex> lock(block_mutex);
+
+                        block_changed.wait(lock, [&]() { return !block_ready[slot] || stopped; });
+
+                        if (stopped) return;
+                    }
+
+                    size_t block_length = fill_decoder(decoder, output_blocks[slot].get(), READ_BLOCK_SIZE);
+
+                    {
+                        lock_guard<mutex> lock(block_mutex);
+
+                        block_lengths[slot] = block_length;
+                        block_ready[slot] = true;
+                    }
+
+                    block_changed.notify_all();
+
+                    // An empty block marks the end of the input
+                    if (block_length == 0) return;
+                }
+            });
+
+            for (size_t slot = 0;; slot ^= 1) {
+                {
+                    unique_lock<mutex> lock(block_mutex);
+
+                    block_changed.wait(lock, [&]() { return block_ready[slot]; });
+                }
+
+                bool keep_going = block_lengths[slot] > 0 && on_block(output_blocks[slot].get(), block_lengths[slot]);
+
+                {
+                    lock_guard<mutex> lock(block_mutex);
+
+                    block_ready[slot] = false;
+                    stopped = !keep_going;
+                }
+
+                block_changed.notify_all();
+
+                if (!keep_going) break;
+            }
+
+            decoder_thread.join();
+        }
+
+        close_decoder(decoder);
+    }
+
+    if (decoder.error.empty()) return true;
+
+    error = decoder.error;
+
+    return false;
+}
+
+void run_parallel(
+    const size_t &task_count,
+    const size_t &jobs,
+    const function<void(size_t)> &task
+) {
+    atomic<size_t> next_task(0);
+    vector<thread> workers;
+
+    auto worker = [&]() {
+        for (size_t task_index; (task_index = next_task.fetch_add(1, memory_order_relaxed)) < task_count;) task(task_index);
+    };
+
+    for (size_t index = 1; index < min(jobs, task_count); ++index) workers.emplace_back(worker);
+
+    worker();
+
+    for (auto &worker_thread : workers) worker_thread.join();
+}
+
+void update_col_width(
+    vector<size_t> &tab_col_width,
+    const size_t *cell_widths,
+    const size_t &cell_count
+) {
+    if (tab_col_width.size() < cell_count) tab_col_width.resize(cell_count, 0);
+
+    for (size_t index = 0; index < cell_count; ++index) tab_col_width[index] = max(tab_col_width[index], cell_widths[index]);
+}
+
+void render_cell(
+    out_buffer &output,
+    string_view tab_cell,
+    size_t cell_width,
+    const size_t &col_index,
+    const bool &header_row,
+    const render_plan &plan
+) {
+    const string &cell_prefix = header_row ? plan.header_cell_prefix : plan.body_cell_prefix;
+    const vector<text_alignment> &col_align = header_row ? plan.header_col_align : plan.body_col_align;
+
+    size_t col_width = plan.col_width[col_index];
+    size_t content_width = plan.col_content_width[col_index];
+    bool truncated = cell_width > content_width;
+
+    // Keep the characters that fit in front of the ellipsis
+    if (truncated) {
+        size_t kept_length = content_width > 0 ? fit_display_width(tab_cell, content_width - 1, cell_width) : 0;
+
+        tab_cell = tab_cell.substr(0, kept_length);
+        truncated = content_width > 0;
+        cell_width = truncated ? cell_width + 1 : 0;
+    }
+
+    size_t col_total_padding = col_width > cell_width ? col_width - cell_width : 0;
+    size_t col_left_padding = (
+        col_align[col_index] == TEXT_ALIGN_RIGHT ? col_total_padding : 
+        col_align[col_index] == TEXT_ALIGN_CENTER ? col_total_padding / 2 : 
+        0
+    );
+
+    out_write(output, cell_prefix);
+    out_fill(output, col_left_padding, SPACE);
+    out_write(output, tab_cell);
+
+    if (truncated) out_write(output, ELLIPSIS);
+
+    out_fill(output, col_total_padding - col_left_padding, SPACE);
+}
+
+/**
+ * @brief Renders one line of cells between the vertical borders.
+ *
+ * @param output       The output writer receiving the line.
+ * @param tab_row      The cells of the line.
+ * @param cell_widths  The display width of each cell of the line.
+ * @param cell_count   Number of cells in the line.
+ * @param header_row   Whether the cells are styled as header cells.
+ * @param plan         The compiled render plan.
+ */
+static inline void render_line(
+    out_buffer &output,
+    const string_view *tab_row,
+    const size_t *cell_widths,
+    const size_t &cell_count,
+    const bool &header_row,
+    const render_plan &plan
+) {
+    out_write(output, plan.row_prefix);
+
+    // Print each cell in the current row
+    for (size_t index = 0; index < plan.max_col_count; ++index) {
+        // Get content for current cell or empty string if missing
+        if (index < cell_count) render_cell(output, tab_row[index], cell_widths[index], index, header_row, plan);
+        else render_cell(output, "", 0, index, header_row, plan);
+
+        out_write(output, plan.cell_suffix);
+    }
+
+    // End of row
+    out_write(output, NEWLINE);
+}
+
+/**
+ * @brief Renders a row over as many lines as its widest cell needs.
+ *
+ * Every line takes the next slice of each cell that fits its column, broken after the
+ * last space of the slice when there is one, and the spaces at the break are dropped.
+ *
+ * @param output       The output writer receiving the lines.
+ * @param tab_row      The cells of the row.
+ * @param cell_widths  The display width of each cell of the row.
+ * @param cell_count   Number of cells in the row.
+ * @param header_row   Whether the cells are styled as header cells.
+ * @param plan         The compiled render plan.
+ */
+static void render_wrapped_lines(
+    out_buffer &output,
+    const string_view *tab_row,
+    const size_t *cell_widths,
+    const size_t &cell_count,
+    const bool &header_row,
+    const render_plan &plan
+) {
+    size_t line_cell_count = min(cell_count, plan.max_col_count);
+
+    vector<string_view> cell_rests(tab_row, tab_row + line_cell_count);        // Part of each cell left to render
+    vector<size_t> rest_widths(cell_widths, cell_widths + line_cell_count);  // Display width of each part left
+    vector<string_view> line_cells(line_cell_count);
+    vector<size_t> line_widths(line_cell_count);
+
+    for (bool lines_left = true; lines_left;) {
+        lines_left = false;
+
+        for (size_t index = 0; index < line_cell_count; ++index) {
+            string_view &cell_rest = cell_rests[index];
+            size_t content_width = plan.col_content_width[index];
+            size_t line_width = rest_widths[index];
+            size_t line_length = cell_rest.length();
+
+            if (line_width > content_width) {
+                line_length = fit_display_width(cell_rest, content_width, line_width);
+
+                // Break after the last space when the slice ends inside a word
+                size_t break_index = line_length < cell_rest.length() && cell_rest[line_length] != SPACE ? cell_rest.rfind(SPACE, line_length) : string_view::npos;
+
+                if (break_index != string_view::npos && break_index > 0) {
+                    line_length = break_index;
+                    line_width = get_display_width(cell_rest.substr(0, line_length));
+                }
+
+                // A character wider than the column is left to the ellipsis
+                if (line_length == 0) {
+                    line_length = cell_rest.length();
+                    line_width = rest_widths[index];
+                }
+            }
+
+            line_cells[index] = cell_rest.substr(0, line_length);
+            line_widths[index] = line_width;
+
+            size_t rest_width = rest_widths[index] - line_width;
+
+            cell_rest.remove_prefix(line_length);
+
+            // The spaces at the break are not carried over to the next line
+            for (; !cell_rest.empty() && cell_rest.front() == SPACE; --rest_width) cell_rest.remove_prefix(1);
+
+            rest_widths[index] = rest_width;
+            lines_left |= !cell_rest.empty();
+        }
+
+        render_line(output, line_cells.data(), line_widths.data(), line_cell_count, header_row, plan);
+    }
+}
+
+void render_row(
+    out_buffer &output,
+    const string_view *tab_row,
+    const size_t *cell_widths,
+    const size_t &cell_count,
+    const bool &first_line,
+    const render_plan &plan
+) {
+    const tab_render_options &render_options = *plan.options;
+
+    bool header_row = first_line && !render_options.headerless;
+    bool wrap_row = false;
+
+    // Render top border if it's the first line and table borders are enabled
+    if (first_line && render_options.use_border) out_write(output, plan.top_border);
+
+    if (plan.wrap_cells) {
+        for (size_t index = 0; index < min(cell_count, plan.max_col_count) && !wrap_row; ++index) wrap_row = cell_widths[index] > plan.col_content_width[index];
+    }
+
+    // Body lines go through the plan's specialized kernel unless a cell has to be truncated
+    if (wrap_row) render_wrapped_lines(output, tab_row, cell_widths, cell_count, header_row, plan);
+    else if (header_row || plan.body_line_kernel == NULL || !plan.body_line_kernel(output, tab_row, cell_widths, cell_count, plan)) render_line(output, tab_row, cell_widths, cell_count, header_row, plan);
+
+    // Render header-body separator after the first line if enabled
+    if (header_row && render_options.use_border && render_options.use_separator) out_write(output, plan.separator_border);
+}
+
+void render_bottom_border(
+    out_buffer &output,
+    const render_plan &plan
+) {
+    const tab_render_options &render_options = *plan.options;
+
+    if (render_options.use_border) out_write(output, plan.bottom_border);
+}
+
+void write_escaped_cell(
+    out_buffer &output,
+    const string_view &tab_cell,
+    const output_format &format
+) {
+    bool quote_cell = format == FORMAT_CSV && tab_cell.find_first_of(",\"\r\n") != string_view::npos;
+
+    if (quote_cell || format == FORMAT_JSON) out_write(output, '"');
+
+    size_t run_begin = 0;
+
+    for (size_t index = 0; index < tab_cell.length(); ++index) {
+        unsigned char cell_char = static_cast<unsigned char>(tab_cell[index]);
+        const char *escaped = NULL;
+        char escaped_control[7];
+
+        if (format == FORMAT_TSV) {
+            if (cell_char == '\\') escaped = "\\\\";
+            else if (cell_char == TAB) escaped = "\\t";
+            else if (cell_char == NEWLINE) escaped = "\\n";
+            else if (cell_char == '\r') escaped = "\\r";
+        }
+        else if (format == FORMAT_CSV) {
+            if (cell_char == '"') escaped = "\"\"";
+        }
+        else if (format == FORMAT_JSON) {
+            if (cell_char == '"') escaped = "\\\"";
+            else if (cell_char == '\\') escaped = "\\\\";
+            else if (cell_char < 0x20) {
+                snprintf(escaped_control, sizeof(escaped_control), "\\u%04x", cell_char);
+
+                escaped = escaped_control;
+            }
+        }
+        else if (format == FORMAT_MARKDOWN) {
+            if (cell_char == '|') escaped = "\\|";
+        }
+
+        if (escaped == NULL) continue;
+
+        out_write(output, tab_cell.substr(run_begin, index - run_begin));
+        out_write(output, escaped);
+
+        run_begin = index + 1;
+    }
+
+    out_write(output, tab_cell.substr(run_begin));
+
+    if (quote_cell || format == FORMAT_JSON) out_write(output, '"');
+}
+
+void write_markdown_line(
+    out_buffer &output,
+    const string_view *tab_row,
+    const size_t &cell_count,
+    const size_t &max_col_count
+) {
+    out_write(output, '|');
+
+    for (size_t index = 0; index < max_col_count; ++index) {
+        out_write(output, SPACE);
+
+        if (index < cell_count) write_escaped_cell(output, tab_row[index], FORMAT_MARKDOWN);
+
+        out_write(output, " |");
+    }
+
+    out_write(output, NEWLINE);
+}
+
+void write_table_begin(table_writer &writer) {
+    if (writer.format == FORMAT_JSON) out_write(*writer.output, '[');
+}
+
+void write_table_row(
+    table_writer &writer,
+    const string_view *tab_row,
+    const size_t *cell_widths,
+    const size_t &cell_count
+) {
+    out_buffer &output = *writer.output;
+    bool first_line = writer.row_index++ == 0;
+
+    switch (writer.format) {
+        case FORMAT_PRETTY:
+            render_row(output, tab_row, cell_widths, cell_count, first_line, *writer.plan);
+
+            break;
+        case FORMAT_TSV:
+        case FORMAT_CSV:
+            for (size_t index = 0; index < cell_count; ++index) {
+                if (index > 0) out_write(output, writer.format == FORMAT_TSV ? TAB : ',');
+
+                write_escaped_cell(output, tab_row[index], writer.format);
+            }
+
+            out_write(output, NEWLINE);
+
+            break;
+        case FORMAT_JSON:
+            if (first_line && !writer.headerless) {
+                writer.header_row = tab_row;
+                writer.header_cell_count = cell_count;
+
+                break;
+            }
+
+            out_write(output, writer.record_count++ > 0 ? ",\n  " : "\n  ");
+            out_write(output, writer.header_row != NULL ? '{' : '[');
+
+            for (size_t index = 0; index < cell_count; ++index) {
+                if (index > 0) out_write(output, ", ");
+
+                if (writer.header_row != NULL) {
+                    // Members beyond the header are named after their column number
+                    if (index < writer.header_cell_count) write_escaped_cell(output, writer.header_row[index], FORMAT_JSON);
+                    else write_escaped_cell(output, to_string(index + 1), FORMAT_JSON);
+
+                    out_write(output, ": ");
+                }
+
+                write_escaped_cell(output, tab_row[index], FORMAT_JSON);
+            }
+
+            out_write(output, writer.header_row != NULL ? '}' : ']');
+
+            break;
+        case FORMAT_MARKDOWN:
+            if (first_line) {
+                // A headerless table gets an empty header line
+                write_markdown_line(output, tab_row, writer.headerless ? 0 : cell_count, writer.max_col_count);
+
+                out_write(output, '|');
+
+                for (size_t index = 0; index < writer.max_col_count; ++index) {
+                    out_write(output, writer.col_align == TEXT_ALIGN_RIGHT ? " ---: |" : writer.col_align == TEXT_ALIGN_CENTER ? " :---: |" : " --- |");
+                }
+
+                out_write(output, NEWLINE);
+
+                if (!writer.headerless) break;
+            }
+
+            write_markdown_line(output, tab_row, cell_count, writer.max_col_count);
+
+            break;
+    }
+}
+
+void write_table_end(table_writer &writer) {
+    out_buffer &output = *writer.output;
+
+    if (writer.format == FORMAT_PRETTY) render_bottom_border(output, *writer.plan);
+    else if (writer.format == FORMAT_JSON) out_write(output, writer.record_count > 0 ? "\n]\n" : "]\n");
+}
+
+void write_table_footer(
+    table_writer &writer,
+    const tab_store &footer_store
+) {
+    const vector<size_t> &row_offsets = footer_store.row_offsets;
+    size_t row_count = store_row_count(footer_store);
+
+    if (row_count == 0) return;
+
+    // Set the footer apart from the body like the header
+    if (writer.format == FORMAT_PRETTY && writer.plan->options->use_border && writer.plan->options->use_separator) out_write(*writer.output, writer.plan->separator_border);
+
+    for (size_t row_index = 0; row_index < row_count; ++row_index) {
+        write_table_row(writer, &footer_store.cells[row_offsets[row_index]], &footer_store.cell_widths[row_offsets[row_index]], row_offsets[row_index + 1] - row_offsets[row_index]);
+    }
+}
+
+void load_table_parallel(
+    const char *input,
+    const size_t &input_length,
+    const tab_parser &parser_template,
+    const vector<string> &usrinput_header_data,
+    const size_t &jobs,
+    tab_store &cmdout_tab_data,
+    vector<size_t> &tab_col_width
+) {
+    vector<size_t> chunk_bounds = { 0 };
+
+    // Split the input at the first newline after every even share
+    for (size_t index = 1; index < jobs; ++index) {
+        size_t chunk_begin = max(chunk_bounds.back(), input_length / jobs * index);
+
+        if (chunk_begin >= input_length) break;
+
+        const void *newline = memchr(input + chunk_begin, NEWLINE, input_length - chunk_begin);
+
+        if (newline == NULL) break;
+
+        size_t chunk_end = static_cast<const char *>(newline) - input + 1;
+
+        if (chunk_end > chunk_bounds.back() && chunk_end < input_length) chunk_bounds.push_back(chunk_end);
+    }
+
+    chunk_bounds.push_back(input_length);
+
+    size_t chunk_count = chunk_bounds.size() - 1;
+
+    vector<tab_store> chunk_stores(chunk_count);
+    vector<vector<size_t>> chunk_col_width(chunk_count);
+
+    // Tokenize every chunk into its own store
+    run_parallel(chunk_count, jobs, [&](size_t chunk_index) {
+        tab_parser chunk_parser = parser_template;
+        tab_store &chunk_store = chunk_stores[chunk_index];
+
+        chunk_store.parse_numbers = cmdout_tab_data.parse_numbers;
+
+        row_handler keep_row = [&](vector<string_view> &tab_row) { store_row(chunk_store, tab_row, input, input + input_length); };
+
+        // Only the first chunk holds the first line
+        if (chunk_index > 0) {
+            chunk_parser.first_line = false;
+            chunk_parser.header_pending = false;
+        }
+
+        parse_block(chunk_parser, input + chunk_bounds[chunk_index], chunk_bounds[chunk_index + 1] - chunk_bounds[chunk_index], keep_row);
+        parse_finish(chunk_parser, keep_row);
+    });
+
+    // Sets the header data on the first stored row
+    if (!usrinput_header_data.empty()) {
+        for (auto &chunk_store : chunk_stores) {
+            if (store_row_count(chunk_store) == 0) continue;
+
+            store_replace_row(chunk_store, 0, usrinput_header_data);
+
+            break;
+        }
+    }
+
+    // Place every chunk at its final position in the merged store
+    vector<size_t> cell_base(chunk_count + 1, 0), row_base(chunk_count + 1, 0);
+
+    for (size_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+        cell_base[chunk_index + 1] = cell_base[chunk_index] + chunk_stores[chunk_index].cells.size();
+        row_base[chunk_index + 1] = row_base[chunk_index] + store_row_count(chunk_stores[chunk_index]);
+    }
+
+    store_clear(cmdout_tab_data);
+
+    cmdout_tab_data.cells.resize(cell_base[chunk_count]);
+    cmdout_tab_data.cell_widths.resize(cell_base[chunk_count]);
+    cmdout_tab_data.cell_numbers.resize(cmdout_tab_data.parse_numbers ? cell_base[chunk_count] : 0);
+    cmdout_tab_data.row_offsets.resize(row_base[chunk_count] + 1);
+    cmdout_tab_data.row_offsets[row_base[chunk_count]] = cell_base[chunk_count];
+
+    // Merge the chunks and compute their partial column widths
+    run_parallel(chunk_count, jobs, [&](size_t chunk_index) {
+        const tab_store &chunk_store = chunk_stores[chunk_index];
+        size_t chunk_row_count = store_row_count(chunk_store);
+
+        copy(chunk_store.cells.begin(), chunk_store.cells.end(), cmdout_tab_data.cells.begin() + cell_base[chunk_index]);
+        copy(chunk_store.cell_widths.begin(), chunk_store.cell_widths.end(), cmdout_tab_data.cell_widths.begin() + cell_base[chunk_index]);
+        copy(chunk_store.cell_numbers.begin(), chunk_store.cell_numbers.end(), cmdout_tab_data.cell_numbers.begin() + cell_base[chunk_index]);
+
+        for (size_t row_index = 0; row_index < chunk_row_count; ++row_index) {
+            size_t row_begin = chunk_store.row_offsets[row_index];
+
+            cmdout_tab_data.row_offsets[row_base[chunk_index] + row_index] = cell_base[chunk_index] + row_begin;
+
+            update_col_width(chunk_col_width[chunk_index], chunk_store.cell_widths.data() + row_begin, chunk_store.row_offsets[row_index + 1] - row_begin);
+        }
+    });
+
+    // Reduce the partial widths and keep the arenas alive in the merged store
+    tab_col_width.clear();
+
+    for (size_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+        const vector<size_t> &col_width = chunk_col_width[chunk_index];
+
+        if (tab_col_width.size() < col_width.size()) tab_col_width.resize(col_width.size(), 0);
+
+        for (size_t index = 0; index < col_width.size(); ++index) tab_col_width[index] = max(tab_col_width[index], col_width[index]);
+
+        for (auto &arena_block : chunk_stores[chunk_index].arena_blocks) cmdout_tab_data.arena_blocks.push_back(move(arena_block));
+    }
+
+    // An empty input has no rows at all
+    if (cmdout_tab_data.cells.empty() && row_base[chunk_count] == 0) cmdout_tab_data.row_offsets.clear();
+}
+
+void render_table_parallel(
+    out_buffer &output,
+    const tab_store &cmdout_tab_data,
+    const render_plan &plan,
+    const size_t &jobs
+) {
+    size_t row_count = store_row_count(cmdout_tab_data);
+    size_t batch_count = (row_count + RENDER_BATCH_ROWS - 1) / RENDER_BATCH_ROWS;
+    vector<out_buffer> batch_output(jobs, { -1, "", NULL });
+
+    out_flush(output);
+
+    for (size_t round_begin = 0; round_begin < batch_count; round_begin += jobs) {
+        size_t round_size = min(jobs, batch_count - round_begin);
+
+        run_parallel(round_size, jobs, [&](size_t task_index) {
+            size_t row_begin = (round_begin + task_index) * RENDER_BATCH_ROWS;
+            size_t row_end = min(row_count, row_begin + RENDER_BATCH_ROWS);
+
+            for (size_t row_index = row_begin; row_index < row_end; ++row_index) {
+                size_t cell_begin = cmdout_tab_data.row_offsets[row_index];
+
+                render_row(batch_output[task_index], cmdout_tab_data.cells.data() + cell_begin, cmdout_tab_data.cell_widths.data() + cell_begin, cmdout_tab_data.row_offsets[row_index + 1] - cell_begin, row_index == 0, plan);
+            }
+        });
+
+        // Write the batches in row order
+        for (size_t task_index = 0; task_index < round_size; ++task_index) {
+            write_block(output.file_descriptor, batch_output[task_index].data.data(), batch_output[task_index].data.size());
+
+            output_byte_count.fetch_add(batch_output[task_index].data.size(), memory_order_relaxed);
+
+            batch_output[task_index].data.clear();
+        }
+    }
+}
+
+/**
+ * @brief Returns the cell of a row in a column, empty when the row is too short.
+ *
+ * @param store      The cell store.
+ * @param row_index  The row.
+ * @param col_index  The column.
+ *
+ * @return The cell.
+ */
+inline string_view store_cell(
+    const tab_store &store,
+    const size_t &row_index,
+    const size_t &col_index
+) {
+    size_t cell_index = store.row_offsets[row_index] + col_index;
+
+    return cell_index < store.row_offsets[row_index + 1] ? store.cells[cell_index] : string_view();
+}
+
+/**
+ * @brief Orders two rows by their sort keys.
+ *
+ * Numeric sorts put the cells without a number last in both directions. Text sorts compare
+ * the key prefixes and only read the cells themselves when the prefixes are equal.
+ *
+ * @param left   Key of the first row.
+ * @param right  Key of the second row.
+ * @param store  The cell store, read on prefix ties.
+ * @param spec   The sort settings.
+ *
+ * @return `true` if the first row comes strictly before the second one.
+ */
+inline bool sort_key_less(
+    const sort_key &left,
+    const sort_key &right,
+    const tab_store &store,
+    const sort_spec &spec
+) {
+    if (spec.kind == SORT_NUM) {
+        bool left_nan = isnan(left.number);
+        bool right_nan = isnan(right.number);
+
+        if (left_nan || right_nan) return !left_nan && right_nan;
+
+        return spec.descending ? left.number > right.number : left.number < right.number;
+    }
+
+    int order = left.prefix < right.prefix ? -1 : left.prefix > right.prefix ? 1 : 0;
+
+    if (order == 0) order = store_cell(store, left.row_index, spec.sort_col).compare(store_cell(store, right.row_index, spec.sort_col));
+
+    return spec.descending ? order > 0 : order < 0;
+}
+
+sort_key make_sort_key(
+    const tab_store &store,
+    const size_t &row_index,
+    const sort_spec &spec
+) {
+    string_view tab_cell = store_cell(store, row_index, spec.sort_col);
+    sort_key key = { NAN, 0, row_index };
+
+    if (spec.kind == SORT_NUM) {
+        size_t cell_index = store.row_offsets[row_index] + spec.sort_col;
+        bool is_stored = store.parse_numbers && cell_index < store.row_offsets[row_index + 1];
+
+        // Reuse the number parsed as the row was stored, else parse it here, sizes comparing by their unit either way
+        cell_number parsed = is_stored ? store.cell_numbers[cell_index] : parse_cell_number(tab_cell);
+        double number;
+
+        if (parsed.kind >= NUMBER_INTEGER) key.number = parsed.value;
+        else if (from_chars(tab_cell.data(), tab_cell.data() + tab_cell.length(), number).ptr != tab_cell.data()) key.number = number;
+    }
+    else {
+        for (size_t index = 0; index < sizeof(key.prefix); ++index) {
+            key.prefix = key.prefix << 8 | (index < tab_cell.length() ? static_cast<unsigned char>(tab_cell[index]) : 0);
+        }
+    }
+
+    return key;
+}
+
+void store_reorder_rows(
+    tab_store &store,
+    const vector<size_t> &row_order
+) {
+    vector<string_view> cells;
+    vector<size_t> cell_widths;
+    vector<cell_number> cell_numbers;
+    vector<size_t> row_offsets(1, 0);
+
+    cells.reserve(store.cells.size());
+    cell_widths.reserve(store.cell_widths.size());
+    cell_numbers.reserve(store.cell_numbers.size());
+    row_offsets.reserve(row_order.size() + 1);
+
+    for (const auto &row_index : row_order) {
+        size_t row_begin = store.row_offsets[row_index];
+        size_t row_end = store.row_offsets[row_index + 1];
+
+        cells.insert(cells.end(), store.cells.begin() + row_begin, store.cells.begin() + row_end);
+        cell_widths.insert(cell_widths.end(), store.cell_widths.begin() + row_begin, store.cell_widths.begin() + row_end);
+
+        if (store.parse_numbers) cell_numbers.insert(cell_numbers.end(), store.cell_numbers.begin() + row_begin, store.cell_numbers.begin() + row_end);
+
+        row_offsets.push_back(cells.size());
+    }
+
+    store.cells.swap(cells);
+    store.cell_widths.swap(cell_widths);
+    store.cell_numbers.swap(cell_numbers);
+    store.row_offsets.swap(row_offsets);
+}
+
+void sort_table(
+    tab_store &store,
+    const sort_spec &spec,
+    const size_t &header_row_count,
+    const size_t &head_rows,
+    const size_t &tail_rows,
+    const size_t &jobs
+) {
+    size_t row_count = store_row_count(store);
+
+    if (row_count <= header_row_count) return;
+
+    size_t key_count = row_count - header_row_count;
+    size_t run_count = key_count >= SORT_PARALLEL_ROWS ? max<size_t>(jobs, 1) : 1;
+
+    vector<sort_key> keys(key_count);
+    vector<size_t> run_bounds(run_count + 1);
+
+    auto key_less = [&](const sort_key &left, const sort_key &right) { return sort_key_less(left, right, store, spec); };
+
+    for (size_t run_index = 0; run_index <= run_count; ++run_index) run_bounds[run_index] = key_count * run_index / run_count;
+
+    // Compute the keys and sort each run on its own thread
+    run_parallel(run_count, jobs, [&](size_t run_index) {
+        for (size_t index = run_bounds[run_index]; index < run_bounds[run_index + 1]; ++index) keys[index] = make_sort_key(store, header_row_count + index, spec);
+
+        stable_sort(keys.begin() + run_bounds[run_index], keys.begin() + run_bounds[run_index + 1], key_less);
+    });
+
+    // Merge neighbouring runs pairwise until one run is left
+    vector<sort_key> merged_keys(run_count > 1 ? key_count : 0);
+
+    for (size_t run_step = 1; run_step < run_count; run_step *= 2) {
+        size_t pair_count = (run_count + 2 * run_step - 1) / (2 * run_step);
+
+        run_parallel(pair_count, jobs, [&](size_t pair_index) {
+            size_t range_begin = run_bounds[pair_index * 2 * run_step];
+            size_t range_middle = run_bounds[min(run_count, pair_index * 2 * run_step + run_step)];
+            size_t range_end = run_bounds[min(run_count, (pair_index + 1) * 2 * run_step)];
+
+            merge(keys.begin() + range_begin, keys.begin() + range_middle, keys.begin() + range_middle, keys.begin() + range_end, merged_keys.begin() + range_begin, key_less);
+        });
+
+        keys.swap(merged_keys);
+    }
+
+    // The header first, then the sorted rows, skipping the middle ones past --head and --tail
+    size_t kept_head = key_count;
+    size_t kept_tail = 0;
+
+    if (head_rows > 0 || tail_rows > 0) {
+        kept_head = min(head_rows, key_count);
+        kept_tail = min(tail_rows, key_count - kept_head);
+    }
+
+    vector<size_t> row_order;
+
+    row_order.reserve(header_row_count + kept_head + kept_tail);
+
+    for (size_t row_index = 0; row_index < header_row_count; ++row_index) row_order.push_back(row_index);
+
+    for (size_t index = 0; index < kept_head; ++index) row_order.push_back(keys[index].row_index);
+
+    for (size_t index = key_count - kept_tail; index < key_count; ++index) row_order.push_back(keys[index].row_index);
+
+    store_reorder_rows(store, row_order);
+}
+
+void get_col_kinds(
+    const tab_store &store,
+    const size_t &first_body_row,
+    vector<number_kind> &col_kinds
+) {
+    size_t row_count = store_row_count(store);
+
+    // Bit set of the cell kinds seen in each column
+    vector<unsigned> seen_kinds;
+
+    for (size_t row_index = first_body_row; row_index < row_count; ++row_index) {
+        size_t row_begin = store.row_offsets[row_index];
+        size_t cell_count = store.row_offsets[row_index + 1] - row_begin;
+
+        if (seen_kinds.size() < cell_count) seen_kinds.resize(cell_count, 0);
+
+        for (size_t index = 0; index < cell_count; ++index) seen_kinds[index] |= 1u << store.cell_numbers[row_begin + index].kind;
+    }
+
+    col_kinds.assign(seen_kinds.size(), NUMBER_NONE);
+
+    for (size_t index = 0; index < seen_kinds.size(); ++index) {
+        unsigned kinds = seen_kinds[index] & ~(1u << NUMBER_EMPTY);
+
+        // Text, or an empty column
+        if (kinds == 0 || kinds & 1u << NUMBER_NONE) continue;
+
+        if (kinds & 1u << NUMBER_PERCENT) col_kinds[index] = kinds == 1u << NUMBER_PERCENT ? NUMBER_PERCENT : NUMBER_NONE;
+        else if (kinds & 1u << NUMBER_SIZE) col_kinds[index] = NUMBER_SIZE;
+        else if (kinds & 1u << NUMBER_FLOAT) col_kinds[index] = NUMBER_FLOAT;
+        else col_kinds[index] = NUMBER_INTEGER;
+    }
+}
+
+void align_numeric_cols(
+    render_plan &plan,
+    const vector<number_kind> &col_kinds
+) {
+    for (size_t index = 0; index < plan.max_col_count && index < col_kinds.size(); ++index) {
+        if (col_kinds[index] == NUMBER_NONE) continue;
+
+        plan.header_col_align[index] = TEXT_ALIGN_RIGHT;
+        plan.body_col_align[index] = TEXT_ALIGN_RIGHT;
+    }
+
+    select_line_kernel(plan);
+}
+
+string format_number(
+    const double &value,
+    const number_kind &kind,
+    const size_t &decimals
+) {
+    char formatted[64];
+
+    if (kind == NUMBER_SIZE && fabs(value) >= 1024) {
+        double scaled = value;
+        size_t unit_index = 0;
+
+        // Scale down to the largest unit the size reaches
+        for (scaled /= 1024; fabs(scaled) >= 1024 && unit_index + 1 < SIZE_UNITS.length(); scaled /= 1024) ++unit_index;
+
+        snprintf(formatted, sizeof(formatted), "%.*f%c", fabs(scaled) < 10 ? 1 : 0, scaled, SIZE_UNITS[unit_index]);
+    }
+    else {
+        int precision = kind == NUMBER_SIZE ? 0 : static_cast<int>(min(decimals, static_cast<size_t>(15)));
+
+        snprintf(formatted, sizeof(formatted), kind == NUMBER_PERCENT ? "%.*f%%" : "%.*f", precision, value);
+    }
+
+    return formatted;
+}
+
+void get_footer_rows(
+    const tab_store &store,
+    const size_t &first_body_row,
+    const vector<number_kind> &col_kinds,
+    const vector<footer_aggregate> &aggregates,
+    vector<vector<string>> &footer_rows
+) {
+    size_t row_count = store_row_count(store);
+    size_t col_count = col_kinds.size();
+
+    footer_rows.clear();
+
+    if (count(col_kinds.begin(), col_kinds.end(), NUMBER_NONE) == static_cast<ptrdiff_t>(col_count)) return;
+
+    vector<double> col_sum(col_count, 0), col_min(col_count, INFINITY), col_max(col_count, -INFINITY);
+    vector<size_t> col_number_count(col_count, 0), col_decimals(col_count, 0);
+
+    // Reduce every column in one pass, cells that are not numbers adding nothing
+    for (size_t row_index = first_body_row; row_index < row_count; ++row_index) {
+        size_t row_begin = store.row_offsets[row_index];
+        size_t cell_count = min(store.row_offsets[row_index + 1] - row_begin, col_count);
+        const cell_number *row_numbers = &store.cell_numbers[row_begin];
+
+        for (size_t index = 0; index < cell_count; ++index) {
+            bool is_number = row_numbers[index].kind >= NUMBER_INTEGER;
+            double value = row_numbers[index].value;
+
+            col_sum[index] += is_number ? value : 0;
+            col_min[index] = min(col_min[index], is_number ? value : INFINITY);
+            col_max[index] = max(col_max[index], is_number ? value : -INFINITY);
+            col_number_count[index] += is_number;
+            col_decimals[index] = max(col_decimals[index], static_cast<size_t>(row_numbers[index].decimals));
+        }
+    }
+
+    for (const auto &aggregate : aggregates) {
+        vector<string> footer_row(col_count);
+
+        for (size_t index = 0; index < col_count; ++index) {
+            if (col_kinds[index] == NUMBER_NONE || col_number_count[index] == 0) continue;
+
+            if (aggregate == FOOTER_SUM) footer_row[index] = format_number(col_sum[index], col_kinds[index], col_decimals[index]);
+            else if (aggregate == FOOTER_AVG) footer_row[index] = format_number(col_sum[index] / col_number_count[index], col_kinds[index], col_decimals[index] + 1);
+            else if (aggregate == FOOTER_MIN) footer_row[index] = format_number(col_min[index], col_kinds[index], col_decimals[index]);
+            else footer_row[index] = format_number(col_max[index], col_kinds[index], col_decimals[index]);
+        }
+
+        // The label always leads the row, ahead of the value when the first column is numeric too
+        for (const auto &entry : FOOTER_AGGREGATES) {
+            if (entry.aggregate == aggregate) footer_row[0] = footer_row[0].empty() ? string(entry.name) : string(entry.name) + " " + footer_row[0];
+        }
+
+        footer_rows.push_back(footer_row);
+    }
+}
+
+int stream_table(
+    const int &input_fd,
+    const tab_parser &parser_template,
+    const vector<string> &usrinput_header_data,
+    const int &col_padding,
+    const size_t &max_col_width,
+    const size_t &max_table_width,
+    const tab_render_options &render_options,
+    tab_stats &stats
+) {
+    // Reusable buffer receiving the spilled blocks of the second pass, left uninitialized so that small inputs stay cheap
+    unique_ptr<char[]> cmdout_block(new char[READ_BLOCK_SIZE]);
+
+    vector<size_t> tab_col_width;                // Holds the maximum width of each column for alignment
+    vector<size_t> cell_widths;                  // Display width of each cell of the current row
+
+    // Reader and writer threads, the first pass reading and the second pass writing through them
+    io_pipeline pipeline = {};
+
+    // Buffered writer for the rendered table
+    out_buffer table_output = { STDOUT_FILENO, "", &pipeline };
+
+    vector<string_view> header_data(usrinput_header_data.begin(), usrinput_header_data.end());
+
+    bool use_header_data = !usrinput_header_data.empty() && !parser_template.exclude_first_line;
+    bool first_line = true;
+
+    struct stat input_stat;
+
+    // Regular files can be read twice, anything else is spilled to a temporary file
+    int spill_fd = input_fd;
+    FILE *spill_file = NULL;
+
+    if (fstat(input_fd, &input_stat) != 0 || !S_ISREG(input_stat.st_mode) || lseek(input_fd, 0, SEEK_CUR) < 0) {
+        spill_file = tmpfile();
+
+        if (spill_file == NULL) {
+            cerr << "Error: Unable to create a temporary file for the '--stream' option" << endl;
+
+            return 1;  // Exit with error
+        }
+
+        spill_fd = fileno(spill_file);
+    }
+
+    off_t input_start = spill_file == NULL ? lseek(input_fd, 0, SEEK_CUR) : 0;
+
+    pipeline_start(pipeline, input_fd, STDOUT_FILENO);
+
+    // --------------------------------------------------
+    // First Pass: Compute Column Widths
+    // --------------------------------------------------
+
+    tab_parser width_parser = parser_template;
+    row_handler measure_row = [&](vector<string_view> &tab_row) {
+        const vector<string_view> &measured_row = first_line && use_header_data ? header_data : tab_row;
+
+        get_cell_widths(measured_row.data(), measured_row.size(), cell_widths);
+        update_col_width(tab_col_width, cell_widths.data(), measured_row.size());
+        stats_count_row(stats, measured_row.size());
+
+        first_line = false;
+    };
+
+    const char *input_block;
+    ssize_t block_length;
+
+    while ((block_length = pipeline_read(pipeline, table_output, input_block)) > 0) {
+        if (spill_file != NULL && !write_block(spill_fd, input_block, block_length)) {
+            cerr << "Error: Unable to write the temporary file for the '--stream' option" << endl;
+
+            pipeline_finish(pipeline, table_output);
+            fclose(spill_file);
+
+            return 1;  // Exit with error
+        }
+
+        parse_block(width_parser, input_block, block_length, measure_row);
+
+        input_byte_count.fetch_add(block_length, memory_order_relaxed);
+    }
+
+    parse_finish(width_parser, measure_row);
+
+    stats_end_phase(stats, PHASE_PARSE);
+
+    clamp_col_widths(tab_col_width, max_col_width, max_table_width, col_padding, render_options.use_border);
+
+    render_plan plan = compile_render_plan(render_options, tab_col_width, col_padding);
+
+    stats_end_phase(stats, PHASE_WIDTHS);
+
+    // --------------------------------------------------
+    // Second Pass: Render Rows
+    // --------------------------------------------------
+
+    tab_parser render_parser = parser_template;
+    row_handler print_row = [&](vector<string_view> &tab_row) {
+        const vector<string_view> &printed_row = first_line && use_header_data ? header_data : tab_row;
+
+        get_cell_widths(printed_row.data(), printed_row.size(), cell_widths);
+        render_row(table_output, printed_row.data(), cell_widths.data(), printed_row.size(), first_line, plan);
+
+        first_line = false;
+    };
+
+    first_line = true;
+
+    lseek(spill_fd, input_start, SEEK_SET);
+
+    while ((block_length = read_block(spill_fd, cmdout_block.get(), READ_BLOCK_SIZE)) > 0) {
+        parse_block(render_parser, cmdout_block.get(), block_length, print_row);
+    }
+
+    parse_finish(render_parser, print_row);
+
+    // Render bottom border of the table if enabled
+    render_bottom_border(table_output, plan);
+    pipeline_finish(pipeline, table_output);
+
+    if (spill_file != NULL) fclose(spill_file);
+
+    stats_end_phase(stats, PHASE_RENDER);
+
+    // Exit successfully
+    return 0;
+}
+
+void fit_live_row(
+    vector<string_view> &tab_row,
+    const vector<size_t> &col_content_width,
+    string &joined_cell
+) {
+    size_t max_col_count = col_content_width.size();
+
+    // Re-lay out overflowing cells into the last column
+    if (max_col_count > 0 && tab_row.size() > max_col_count) {
+        joined_cell = tab_row[max_col_count - 1];
+
+        for (size_t index = max_col_count; index < tab_row.size(); ++index) {
+            joined_cell += SPACE;
+            joined_cell += tab_row[index];
+        }
+
+        tab_row.resize(max_col_count);
+        tab_row[max_col_count - 1] = joined_cell;
+    }
+}
+
+int live_table(
+    const int &input_fd,
+    const tab_parser &parser_template,
+    const vector<string> &usrinput_header_data,
+    const int &col_padding,
+    const size_t &sample_row_count,
+    const vector<size_t> &col_width_hints,
+    const size_t &max_col_width,
+    const size_t &max_table_width,
+    const tab_render_options &render_options,
+    tab_stats &stats
+) {
+    tab_store sampled_rows = {};                 // Rows buffered until the widths are fixed
+    vector<size_t> col_content_width;            // Fixed content width of each column
+    render_plan plan;                            // Render plan compiled once the widths are fixed
+
+    // Reader and writer threads, so that a blocked stdout does not stall reading the input
+    io_pipeline pipeline = {};
+
+    // Buffered writer for the rendered table
+    out_buffer table_output = { STDOUT_FILENO, "", &pipeline };
+
+    vector<string_view> header_data(usrinput_header_data.begin(), usrinput_header_data.end());
+    vector<string_view> fitted_row;              // Reusable copy of a row fitted to the widths
+    vector<size_t> fitted_widths;                // Display width of each cell of the fitted row
+    string joined_cell;                          // Storage for a last cell joined from extra cells
+
+    bool use_header_data = !usrinput_header_data.empty() && !parser_template.exclude_first_line;
+    bool widths_fixed = false;
+    bool first_line = true;
+
+    // Renders a row against the fixed widths
+    auto print_row = [&](const string_view *tab_row, const size_t &cell_count) {
+        fitted_row.assign(tab_row, tab_row + cell_count);
+
+        fit_live_row(fitted_row, col_content_width, joined_cell);
+        get_cell_widths(fitted_row.data(), fitted_row.size(), fitted_widths);
+        render_row(table_output, fitted_row.data(), fitted_widths.data(), fitted_row.size(), first_line, plan);
+
+        first_line = false;
+    };
+
+    // Fixes the column widths from the sampled rows and the hints, then flushes the sample
+    auto fix_widths = [&]() {
+        size_t sampled_row_count = store_row_count(sampled_rows);
+
+        for (size_t row_index = 0; row_index < sampled_row_count; ++row_index) {
+            size_t row_begin = sampled_rows.row_offsets[row_index];
+
+            update_col_width(col_content_width, &sampled_rows.cell_widths[row_begin], sampled_rows.row_offsets[row_index + 1] - row_begin);
+        }
+
+        if (col_content_width.size() < col_width_hints.size()) col_content_width.resize(col_width_hints.size(), 0);
+
+        for (size_t index = 0; index < col_width_hints.size(); ++index) col_content_width[index] = col_width_hints[index];
+
+        clamp_col_widths(col_content_width, max_col_width, max_table_width, col_padding, render_options.use_border);
+
+        plan = compile_render_plan(render_options, col_content_width, col_padding);
+
+        widths_fixed = true;
+
+        for (size_t row_index = 0; row_index < sampled_row_count; ++row_index) {
+            size_t row_begin = sampled_rows.row_offsets[row_index];
+
+            print_row(&sampled_rows.cells[row_begin], sampled_rows.row_offsets[row_index + 1] - row_begin);
+        }
+
+        store_clear(sampled_rows);
+    };
+
+    row_handler live_row = [&](vector<string_view> &tab_row) {
+        const vector<string_view> &received_row = store_row_count(sampled_rows) == 0 && first_line && use_header_data ? header_data : tab_row;
+
+        stats_count_row(stats, received_row.size());
+
+        if (widths_fixed) print_row(received_row.data(), received_row.size());
+        else {
+            store_row(sampled_rows, received_row);
+
+            if (store_row_count(sampled_rows) >= sample_row_count) fix_widths();
+        }
+    };
+
+    // Hints alone are enough to start rendering without a sample
+    if (sample_row_count == 0) fix_widths();
+
+    tab_parser live_parser = parser_template;
+    const char *input_block;
+    ssize_t block_length;
+
+    pipeline_start(pipeline, input_fd, STDOUT_FILENO);
+
+    while (true) {
+        // End the sampling early once the input goes quiet
+        int sample_timeout = !widths_fixed && store_row_count(sampled_rows) > 0 ? LIVE_SAMPLE_TIMEOUT : -1;
+
+        if ((block_length = pipeline_read(pipeline, table_output, input_block, sample_timeout)) < 0) fix_widths();
+        else if (block_length == 0) break;
+        else {
+            parse_block(live_parser, input_block, block_length, live_row);
+
+            input_byte_count.fetch_add(block_length, memory_order_relaxed);
+        }
+
+        // Show the rows of this read right away
+        out_flush(table_output);
+    }
+
+    parse_finish(live_parser, live_row);
+
+    if (!widths_fixed) fix_widths();
+
+    // Render bottom border of the table if enabled
+    render_bottom_border(table_output, plan);
+    pipeline_finish(pipeline, table_output);
+
+    stats_end_phase(stats, PHASE_RENDER);
+
+    // Exit successfully
+    return 0;
+}
+
+const tab_border *find_border_style(const string_view &style_name) {
+    for (const auto &style_entry : BORDER_STYLES) {
+        if (style_name == style_entry.name) return style_entry.border_style;
+    }
+
+    return NULL;
+}
+
+bool apply_theme(
+    const string_view &theme_name,
+    tab_render_options &render_options,
+    char &col_separator
+) {
+    for (const auto &theme : THEMES) {
+        if (theme_name != theme.name) continue;
+
+        render_options.border_style = *theme.border_style;
+
+        if (theme.col_separator >= 0) col_separator = theme.col_separator;
+        if (theme.table_color != NULL) render_options.table_color = theme.table_color;
+        if (theme.header_text_color != NULL) render_options.header_text_color = theme.header_text_color;
+        if (theme.body_text_color != NULL) render_options.body_text_color = theme.body_text_color;
+        if (theme.header_bg_color != NULL) render_options.header_bg_color = theme.header_bg_color;
+        if (theme.body_bg_color != NULL) render_options.body_bg_color = theme.body_bg_color;
+        if (theme.header_text_style != NULL) render_options.header_text_style = theme.header_text_style;
+        if (theme.body_text_style != NULL) render_options.body_text_style = theme.body_text_style;
+        if (theme.header_text_align != NULL) render_options.header_text_align = theme.header_text_align;
+        if (theme.body_text_align != NULL) render_options.body_text_align = theme.body_text_align;
+
+        return true;
+    }
+
+    return false;
+}
+
+// --------------------------------------------------
+// Renderer
+// --------------------------------------------------
+
+tab_render_options default_render_options() {
+    return {
+        false,       // headerless
+        true,        // use_border
+        true,        // use_separator
+        "", "", "",  // table_color, header_text_color, body_text_color
+        "", "",      // header_bg_color, body_bg_color
+        "", "",      // header_text_style, body_text_style
+        ALIGN_LEFT,  // header_text_align
+        ALIGN_LEFT,  // body_text_align
+        SINGLE_BORDER_STYLE  // border_style
+    };
+}
+
+Renderer::Renderer() :
+    render_options(default_render_options()),
+    col_separator(SPACE),
+    col_padding(2),
+    format(FORMAT_PRETTY),
+    max_col_width(0),
+    max_table_width(0),
+    parser(make_parser(SPACE, false)),
+    store(),
+    has_plan(false) {}
+
+void Renderer::set_render_options(const tab_render_options &render_options) {
+    this->render_options = render_options;
+    has_plan = false;
+}
+
+const tab_render_options &Renderer::get_render_options() const {
+    return render_options;
+}
+
+bool Renderer::set_theme(const string_view &theme_name) {
+    has_plan = false;
+
+    if (!apply_theme(theme_name, render_options, col_separator)) return false;
+
+    parser = make_parser(col_separator, false);
+
+    return true;
+}
+
+bool Renderer::set_border_style(const string_view &style_name) {
+    const tab_border *border_style = find_border_style(style_name);
+
+    if (border_style == NULL) return false;
+
+    render_options.border_style = *border_style;
+    has_plan = false;
+
+    return true;
+}
+
+void Renderer::set_padding(const int &col_padding) {
+    this->col_padding = col_padding;
+    has_plan = false;
+}
+
+void Renderer::set_separator(const char &col_separator) {
+    this->col_separator = col_separator;
+    parser = make_parser(col_separator, false);
+}
+
+void Renderer::set_format(const output_format &format) {
+    this->format = format;
+}
+
+void Renderer::set_width_limits(
+    const size_t &max_col_width,
+    const size_t &max_table_width
+) {
+    this->max_col_width = max_col_width;
+    this->max_table_width = max_table_width;
+}
+
+void Renderer::render(
+    const vector<vector<string>> &tab_rows,
+    string &output
+) {
+    store_clear(store);
+
+    store.row_offsets.push_back(0);
+
+    // The cells are views into the rows of the caller
+    for (const auto &tab_row : tab_rows) {
+        for (const auto &tab_cell : tab_row) {
+            store.cells.push_back(tab_cell);
+            store.cell_widths.push_back(get_display_width(tab_cell));
+        }
+
+        store.row_offsets.push_back(store.cells.size());
+    }
+
+    render_store(output);
+}
+
+void Renderer::render_text(
+    const string_view &text,
+    string &output
+) {
+    const char *text_end = text.data() + text.size();
+
+    store_clear(store);
+
+    // The cells are views into the text, only tokens rebuilt by the tokenizer are copied
+    row_handler keep_row = [this, &text, &text_end](vector<string_view> &tab_row) {
+        store_row(store, tab_row, text.data(), text_end);
+    };
+
+    parser.first_line = true;
+
+    parse_block(parser, text.data(), text.size(), keep_row);
+    parse_finish(parser, keep_row);
+
+    render_store(output);
+}
+
+void Renderer::render_store(string &output) {
+    size_t row_count = store_row_count(store);
+    size_t max_col_count = 0;
+    const vector<size_t> &row_offsets = store.row_offsets;
+
+    for (size_t row_index = 0; row_index < row_count; ++row_index) max_col_count = max(max_col_count, row_offsets[row_index + 1] - row_offsets[row_index]);
+
+    // Measure the widest cell of each column
+    col_widths.assign(max_col_count, 0);
+
+    for (size_t row_index = 0; format == FORMAT_PRETTY && row_index < row_count; ++row_index) {
+        const size_t *cell_widths = &store.cell_widths[row_offsets[row_index]];
+        size_t cell_count = row_offsets[row_index + 1] - row_offsets[row_index];
+
+        for (size_t index = 0; index < cell_count; ++index) col_widths[index] = max(col_widths[index], cell_widths[index]);
+    }
+
+    clamp_col_widths(col_widths, max_col_width, max_table_width, col_padding, render_options.use_border);
+
+    // Tables laid out like the previous one reuse its render plan
+    if (format == FORMAT_PRETTY && (!has_plan || plan.col_content_width != col_widths)) {
+        plan = compile_render_plan(render_options, col_widths, col_padding);
+        has_plan = true;
+    }
+
+    // The output writer collects in the buffer of the caller
+    out_buffer table_output = { -1, move(output), NULL };
+
+    table_output.data.clear();
+
+    table_writer writer = { format, &table_output, &plan, render_options.headerless, max_col_count, get_text_alignment(render_options.body_text_align), NULL, 0, 0, 0 };
+
+    write_table_begin(writer);
+
+    for (size_t row_index = 0; row_index < row_count; ++row_index) {
+        size_t cell_begin = row_offsets[row_index];
+
+        write_table_row(writer, &store.cells[cell_begin], &store.cell_widths[cell_begin], row_offsets[row_index + 1] - cell_begin);
+    }
+
+    write_table_end(writer);
+
+    output = move(table_output.data);
+}
+
+}  // namespace tabstijl
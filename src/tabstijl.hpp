@@ -0,0 +1,1587 @@
+// MIT License
+
+// Copyright (c) 2025 Naufal Hanif
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file tabstijl.hpp
+ *
+ * @brief Tokenizes, lays out and renders tabular text (libtabstijl).
+ *
+ * This library holds the engine of the tabstijl command-line tool: the block tokenizer,
+ * the columnar cell store, display width measurement, render plans, the table writers
+ * of every output format, sorting, and the themes and border styles. Programs that
+ * format tables in memory configure a `tabstijl::Renderer` once and reuse it for every
+ * table, without forking the command-line tool.
+ *
+ * @author Naufal Hanif
+ * @date 2025
+ */
+
+#ifndef TABSTIJL_HPP
+#define TABSTIJL_HPP
+
+// --------------------------------------------------
+// Standard Library Includes
+// --------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// --------------------------------------------------
+// POSIX Includes
+// --------------------------------------------------
+
+#include <sys/types.h>
+
+namespace tabstijl {
+
+// --------------------------------------------------
+// ANSI Color and Text Style Escape Sequences
+// --------------------------------------------------
+
+// Text styles
+static constexpr char BOLD[] = "\e[1m";
+static constexpr char DEFAULT[] = "\e[0m";
+static constexpr char INVERSE[] = "\e[7m";
+static constexpr char ITALIC[] = "\e[3m";
+static constexpr char STRIKETHROUGH[] = "\e[9m";
+static constexpr char UNDERLINE[] = "\e[4m";
+
+// Text colors
+static constexpr char BLACK[] = "\e[30m";
+static constexpr char BLUE[] = "\e[34m";
+static constexpr char CYAN[] = "\e[36m";
+static constexpr char GREEN[] = "\e[32m";
+static constexpr char MAGENTA[] = "\e[35m";
+static constexpr char RED[] = "\e[31m";
+static constexpr char WHITE[] = "\e[37m";
+static constexpr char YELLOW[] = "\e[33m";
+
+// Background colors
+static constexpr char BG_BLACK[] = "\e[40m";
+static constexpr char BG_BLUE[] = "\e[44m";
+static constexpr char BG_CYAN[] = "\e[46m";
+static constexpr char BG_GREEN[] = "\e[42m";
+static constexpr char BG_MAGENTA[] = "\e[45m";
+static constexpr char BG_RED[] = "\e[41m";
+static constexpr char BG_WHITE[] = "\e[47m";
+static constexpr char BG_YELLOW[] = "\e[43m";
+
+// Whitespace characters
+static constexpr char NEWLINE = '\n';
+static constexpr char SPACE = ' ';
+static constexpr char TAB = '\t';
+static constexpr char VOID = '\0';
+
+// Input engine
+static constexpr size_t READ_BLOCK_SIZE = 1 << 20;  // Number of bytes requested from stdin per read(2) call
+
+// Output writer
+static constexpr size_t WRITE_BUFFER_SIZE = 1 << 20;  // Number of bytes collected before each write(2) to stdout
+static constexpr size_t FILL_BLOCK_SIZE = 256;         // Bytes of repeated glyphs held by one fill pattern block
+
+// Terminal fitting (--fit)
+static constexpr size_t FIT_SHRINK_LOSS = 4;     // Shrinking is chosen while it hides at most 1/FIT_SHRINK_LOSS of the content
+static constexpr size_t FIT_WRAP_MIN_WIDTH = 8;  // Narrowest column content width that wrapping is chosen for
+
+// Parallel mode
+static constexpr size_t RENDER_BATCH_ROWS = 16384;  // Rows rendered by one worker task before the output is written
+
+// Text alignments
+static constexpr char ALIGN_LEFT[] = "left";
+static constexpr char ALIGN_CENTER[] = "center";
+static constexpr char ALIGN_RIGHT[] = "right";
+
+// Define the border style structs
+// Top border style struct
+typedef struct border_top {
+    std::string_view left_char_unicode;
+    std::string_view mid_char_unicode;
+    std::string_view right_char_unicode;
+    std::string_view fill_char_unicode;
+} border_top;
+
+// Middle/separator border style struct
+typedef struct border_separator {
+    std::string_view left_char_unicode;
+    std::string_view mid_char_unicode;
+    std::string_view right_char_unicode;
+    std::string_view fill_char_unicode;
+} border_separator;
+
+// Bottom border style struct
+typedef struct border_bottom {
+    std::string_view left_char_unicode;
+    std::string_view mid_char_unicode;
+    std::string_view right_char_unicode;
+    std::string_view fill_char_unicode;
+} border_bottom;
+
+// Table border style struct
+typedef struct tab_border {
+    border_top top;
+    border_separator separator;
+    border_bottom bottom;
+    std::string_view vertical_line;
+} tab_border;
+
+// Default single-line table border style using Unicode characters
+static constexpr tab_border SINGLE_BORDER_STYLE = {
+    { "\u250C", "\u252C", "\u2510", "\u2500" },  // Top border: left, mid, right, horizontal line
+    { "\u251C", "\u253C", "\u2524", "\u2500" },  // Separator: left, mid, right, horizontal line
+    { "\u2514", "\u2534", "\u2518", "\u2500" },  // Bottom border: left, mid, right, horizontal line
+    "\u2502"                                     // Vertical line between columns
+};
+
+// Optional double-line border style
+static constexpr tab_border DOUBLE_BORDER_STYLE = {
+    { "\u2554", "\u2566", "\u2557", "\u2550" },
+    { "\u2560", "\u256C", "\u2563", "\u2550" },
+    { "\u255A", "\u2569", "\u255D", "\u2550" },
+    "\u2551"
+};
+
+// Optional heavy-line border style
+static constexpr tab_border HEAVY_BORDER_STYLE = {
+    { "\u250F", "\u2533", "\u2513", "\u2501" },
+    { "\u2523", "\u254B", "\u252B", "\u2501" },
+    { "\u2517", "\u253B", "\u251B", "\u2501" },
+    "\u2503"
+};
+
+// Optional star border style
+static constexpr tab_border STAR_BORDER_STYLE = {
+    { "\u2732", "\u2732", "\u2732", "\u2732" },
+    { "\u2732", "\u2732", "\u2732", "\u2732" },
+    { "\u2732", "\u2732", "\u2732", "\u2732" },
+    "\u2551"
+};
+
+// Named border style struct
+typedef struct border_style_entry {
+    const char *name;                // Value of the --border-style option
+    const tab_border *border_style;  // The border characters
+} border_style_entry;
+
+// Border styles selectable with --border-style
+static constexpr border_style_entry BORDER_STYLES[] = {
+    { "double", &DOUBLE_BORDER_STYLE },
+    { "heavy", &HEAVY_BORDER_STYLE },
+    { "star", &STAR_BORDER_STYLE }
+};
+
+/**
+ * @brief Constructs a single table border row using specified Unicode characters.
+ *
+ * This function generates a string representing one horizontal border row 
+ * (top, separator, or bottom) in a table. It takes into account the width of 
+ * each column and the total number of columns. Each cell's border is drawn 
+ * using the given fill character and separated using a middle junction character.
+ *
+ * The resulting string includes the left and right boundary characters, colored 
+ * with the provided ANSI color code.
+ *
+ * The fill characters of each column are copied from the glyph's fill pattern block
+ * (see `append_fill_run()`). Render plans call this once per border line.
+ * 
+ * @param max_col_count      The total number of columns in the table.
+ * @param col_width          A vector of column widths for each column (includes padding).
+ * @param left_char_unicode  The Unicode character used at the left-most edge of the border.
+ * @param mid_char_unicode   The Unicode character used between columns (junction point).
+ * @param right_char_unicode The Unicode character used at the right-most edge of the border.
+ * @param fill_char_unicode  The character used to fill horizontal space in the border line.
+ * @param table_color        ANSI color escape sequence to apply to the entire border line.
+ * 
+ * @return A string representing a complete table border row, terminated with a newline.
+ */
+std::string get_tab_border(
+    const size_t &max_col_count,
+    const std::vector<size_t> &col_width,
+    const std::string_view &left_char_unicode,
+    const std::string_view &mid_char_unicode,
+    const std::string_view &right_char_unicode,
+    const std::string_view &fill_char_unicode,
+    const std::string &table_color
+);
+
+/**
+ * @brief Determines whether a character is considered a column separator or whitespace.
+ *
+ * This function evaluates if the given character qualifies as a field delimiter
+ * based on the selected `col_separator`. If `col_separator` is one of the standard
+ * whitespace characters, it is treated explicitly. Otherwise, fallback to checking
+ * general whitespace using `isspace()`.
+ *
+ * The tokenizers do not call this per byte; it defines the separator table built once
+ * by `make_parser()`.
+ *
+ * @param current_char     The character to evaluate.
+ * @param col_separator    The user-defined or default column delimiter.
+ * 
+ * @return true if the character is a recognized whitespace or matches the delimiter.
+ */
+bool is_wspace(
+    const char &current_char,
+    const char &col_separator
+);
+
+// Input tokenizer state struct
+typedef struct tab_parser {
+    char col_separator;                           // The column delimiter selected with --separator
+    bool exclude_first_line;                      // Whether tokens of the first input line are dropped
+    bool first_line;                              // Flag to indicate current parsing line is the first
+    std::string pending_token;                    // Partial token carried over a block boundary
+    std::vector<std::string_view> temp_row_data;  // Tokens of the row currently being parsed
+    std::deque<std::string> carried_cells;        // Owned copies of tokens that outlive their block
+    bool separator_table[256];                    // Whether each byte value separates tokens
+    std::vector<int> col_slots;                   // Output position of each input column, -1 if skipped, empty to keep every column
+    size_t last_col_index;                        // Last input column still needed, the rest of a row is skipped
+    size_t where_col;                             // Input column tested by --where, SIZE_MAX for no filter
+    std::string where_text;                       // Substring the --where column must contain
+    bool header_pending;                          // Whether the next row is the header, which always passes the filter
+    size_t col_index;                             // Input column of the next token of the current row
+    bool row_rejected;                            // Whether the current row failed the filter
+} tab_parser;
+
+/**
+ * @brief Creates a tokenizer for the given separator and first line handling.
+ *
+ * The separator rules of `is_wspace()` are compiled into a 256-entry lookup table,
+ * which every tokenizer path uses to classify bytes.
+ *
+ * @param col_separator       The user-defined or default column delimiter.
+ * @param exclude_first_line  Whether tokens of the first input line are dropped.
+ *
+ * @return A tokenizer positioned at the start of the input.
+ */
+tab_parser make_parser(
+    const char &col_separator,
+    const bool &exclude_first_line
+);
+
+/**
+ * @brief Restricts a tokenizer to the given input columns, in the given order.
+ *
+ * Tokens of other columns are never stored, and once the last needed column of a row
+ * has been read the rest of the row is skipped up to the next newline.
+ *
+ * @param parser         The tokenizer to restrict.
+ * @param selected_cols  The input column of each output column (0-based).
+ */
+void select_parser_columns(
+    tab_parser &parser,
+    const std::vector<size_t> &selected_cols
+);
+
+/**
+ * @brief Makes a tokenizer drop the rows whose given column does not contain a substring.
+ *
+ * Rows too short to have the column are dropped too. A rejected row is skipped up to the
+ * next newline without tokenizing the rest of it.
+ *
+ * @param parser            The tokenizer to filter.
+ * @param where_col         The input column to test (0-based).
+ * @param where_text        The substring the column must contain.
+ * @param keep_header_row   Whether the first row is a header, which always passes.
+ */
+void filter_parser_rows(
+    tab_parser &parser,
+    const size_t &where_col,
+    const std::string &where_text,
+    const bool &keep_header_row
+);
+
+// Callback receiving every completed row from the tokenizer, valid only during the call
+typedef std::function<void(std::vector<std::string_view> &)> row_handler;
+
+/**
+ * @brief Finds the first separator byte in a block of input.
+ *
+ * Newline-separated input is scanned with `memchr`. Otherwise whole words are skipped
+ * eight bytes at a time as long as they cannot hold a separator: words without the
+ * separator or a newline for space and tab separators, and words without a byte below
+ * 0x21 for the whitespace separator. The remaining bytes are classified with the
+ * separator table of the tokenizer.
+ *
+ * @param block_begin  Pointer to the first byte to scan.
+ * @param block_end    Pointer one past the last byte to scan.
+ * @param parser       The tokenizer holding the separator table.
+ *
+ * @return Pointer to the first separator byte, or `block_end` if none was found.
+ */
+const char *find_separator(
+    const char *block_begin,
+    const char *block_end,
+    const tab_parser &parser
+);
+
+/**
+ * @brief Tokenizes one block of raw input into table rows.
+ *
+ * Tokens are views into the block itself. A token that reaches the end of the block is
+ * kept in `pending_token` and completed by the next call, so blocks may be split at
+ * arbitrary byte positions. Tokens of a row that continues into the next block are copied
+ * into `carried_cells` before returning. Completed rows are passed to `on_row`.
+ *
+ * @param parser        The tokenizer state carried between blocks.
+ * @param block         Pointer to the block data.
+ * @param block_length  Number of bytes in the block.
+ * @param on_row        Callback receiving each completed row.
+ */
+void parse_block(
+    tab_parser &parser,
+    const char *block,
+    const size_t &block_length,
+    const row_handler &on_row
+);
+
+/**
+ * @brief Flushes the last token and row once the input is exhausted.
+ *
+ * The trailing token is kept even on an excluded first line, matching the behaviour
+ * of input that does not end with a newline.
+ *
+ * @param parser  The tokenizer state carried between blocks.
+ * @param on_row  Callback receiving the last row.
+ */
+void parse_finish(
+    tab_parser &parser,
+    const row_handler &on_row
+);
+
+/**
+ * @brief Returns the number of terminal columns taken by a code point.
+ *
+ * @param code_point  The code point to measure.
+ *
+ * @return 0 for combining and format characters, 2 for wide characters, 1 otherwise.
+ */
+int get_code_point_width(const uint32_t &code_point);
+
+/**
+ * @brief Decodes the UTF-8 sequence starting at a non-ASCII byte.
+ *
+ * @param text         Pointer to the lead byte of the sequence.
+ * @param text_length  Number of bytes available from `text`.
+ * @param code_point   Receives the decoded code point.
+ *
+ * @return The length of the sequence in bytes, or 0 if it is not valid UTF-8.
+ */
+size_t decode_utf8(
+    const char *text,
+    const size_t &text_length,
+    uint32_t &code_point
+);
+
+/**
+ * @brief Measures the longest prefix of a text that fits in a number of terminal columns.
+ *
+ * Runs of ASCII bytes are counted eight bytes at a time, one column per byte. Other bytes
+ * are decoded as UTF-8 and measured with `get_code_point_width()`, and every byte that is
+ * not valid UTF-8 takes one column. Multi-byte sequences are never split.
+ *
+ * @param text          The text to measure.
+ * @param max_width     The number of columns available, `SIZE_MAX` for no limit.
+ * @param prefix_width  Receives the number of columns taken by the prefix.
+ *
+ * @return The length in bytes of the prefix.
+ */
+size_t fit_display_width(
+    const std::string_view &text,
+    const size_t &max_width,
+    size_t &prefix_width
+);
+
+/**
+ * @brief Returns the number of terminal columns taken by a text.
+ *
+ * @param text  The UTF-8 text to measure.
+ *
+ * @return The display width of the text.
+ */
+size_t get_display_width(const std::string_view &text);
+
+/**
+ * @brief Measures the display width of every cell of a row.
+ *
+ * @param tab_row      The cells of the row.
+ * @param cell_count   Number of cells in the row.
+ * @param cell_widths  Receives the display width of each cell.
+ */
+void get_cell_widths(
+    const std::string_view *tab_row,
+    const size_t &cell_count,
+    std::vector<size_t> &cell_widths
+);
+
+// Numeric kinds of a cell
+typedef enum number_kind : uint8_t {
+    NUMBER_NONE,     // Text that is not a number
+    NUMBER_EMPTY,    // Empty cell, fitting a column of any kind
+    NUMBER_INTEGER,  // Integer (e.g. "-42")
+    NUMBER_FLOAT,    // Decimal number (e.g. "3.14" or "1e6")
+    NUMBER_SIZE,     // Size with a binary unit suffix (e.g. "4.0K" of 'du -h', "12MiB" or "512B")
+    NUMBER_PERCENT   // Percentage (e.g. "23%" of 'df')
+} number_kind;
+
+// Unit letters of the sizes, each unit being 1024 times the previous one
+static constexpr std::string_view SIZE_UNITS = "KMGTPE";
+
+// Cached numeric value of a cell struct
+typedef struct cell_number {
+    double value;      // The value, sizes in bytes, NaN unless the cell is a number
+    number_kind kind;  // The numeric kind of the cell
+    uint8_t decimals;  // Number of digits after the decimal point, kept for formatting
+} cell_number;
+
+/**
+ * @brief Parses a cell as a number, a size or a percentage.
+ *
+ * The whole cell must be the number, only its unit suffix may follow it. Size units are
+ * K, M, G, T, P and E (only K also as "k"), optionally followed by "i" and "B", and are powers
+ * of 1024 as in the `-h` output of coreutils.
+ *
+ * @param tab_cell  The cell to parse.
+ *
+ * @return The value, kind and decimal count of the cell.
+ */
+cell_number parse_cell_number(const std::string_view &tab_cell);
+
+// Columnar table cell store struct
+typedef struct tab_store {
+    std::vector<std::unique_ptr<char[]>> arena_blocks;  // Arena blocks holding the bytes of every cell
+    char *arena_cursor;                                 // Next free byte of the current arena block
+    size_t arena_left;                                  // Free bytes left in the current arena block
+    std::vector<std::string_view> cells;                // Every cell of every row, row after row
+    std::vector<size_t> cell_widths;                    // Display width of every cell, parallel to cells
+    std::vector<size_t> row_offsets;                    // Index of the first cell of each row, plus the end
+    bool parse_numbers;                                 // Whether the numbers of the cells are parsed as rows are stored
+    std::vector<cell_number> cell_numbers;              // Numeric value of every cell, parallel to cells when parse_numbers is set
+} tab_store;
+
+/**
+ * @brief Copies bytes into the store arena.
+ *
+ * Arena blocks are never reallocated, so the returned view stays valid for the
+ * lifetime of the store.
+ *
+ * @param store   The cell store owning the arena.
+ * @param bytes   The bytes to copy.
+ *
+ * @return A view of the copied bytes inside the arena.
+ */
+std::string_view store_bytes(
+    tab_store &store,
+    const std::string_view &bytes
+);
+
+/**
+ * @brief Appends a row to the store, copying its cells into the arena.
+ *
+ * Cells that lie inside the stable range `[stable_begin, stable_end)`, such as a memory
+ * mapped input that outlives the store, are kept as views without being copied. The
+ * display width of every cell is measured once here, and so is its number when the store
+ * parses numbers.
+ *
+ * @param store         The cell store receiving the row.
+ * @param tab_row       The cells of the row.
+ * @param stable_begin  Start of the input that outlives the store, or NULL.
+ * @param stable_end    End of the input that outlives the store, or NULL.
+ */
+void store_row(
+    tab_store &store,
+    const std::vector<std::string_view> &tab_row,
+    const char *stable_begin = NULL,
+    const char *stable_end = NULL
+);
+
+/**
+ * @brief Replaces the cells of one stored row.
+ *
+ * Used for the --hdata header, which may have a different number of cells than the row
+ * it replaces. The cells of the following rows are shifted accordingly.
+ *
+ * @param store      The cell store holding the row.
+ * @param row_index  Index of the row to replace.
+ * @param tab_row    The new cells of the row.
+ */
+void store_replace_row(
+    tab_store &store,
+    const size_t &row_index,
+    const std::vector<std::string> &tab_row
+);
+
+/**
+ * @brief Returns the number of rows held by the store.
+ *
+ * @param store  The cell store.
+ *
+ * @return The number of stored rows.
+ */
+size_t store_row_count(const tab_store &store);
+
+/**
+ * @brief Removes every row from the store and releases the arena.
+ *
+ * Whether the store parses numbers is kept.
+ *
+ * @param store  The cell store to clear.
+ */
+void store_clear(tab_store &store);
+
+/**
+ * @brief Reads a block of bytes from a file descriptor, retrying on signal interruption.
+ *
+ * @param file_descriptor  The descriptor to read from.
+ * @param buffer           Destination buffer.
+ * @param buffer_size      Capacity of the destination buffer.
+ *
+ * @return The number of bytes read, 0 on end of input, or -1 on error.
+ */
+ssize_t read_block(
+    const int &file_descriptor,
+    char *buffer,
+    const size_t &buffer_size
+);
+
+/**
+ * @brief Writes a whole block of bytes to a file descriptor.
+ *
+ * Short writes and signal interruptions are retried until every byte is written.
+ *
+ * @param file_descriptor  The descriptor to write to.
+ * @param buffer           Source buffer.
+ * @param buffer_size      Number of bytes to write.
+ *
+ * @return true if the whole block was written, false on error.
+ */
+bool write_block(
+    const int &file_descriptor,
+    const char *buffer,
+    size_t buffer_size
+);
+
+// Reader and writer threads overlapping the I/O of --live and --stream with the rendering
+struct io_pipeline;
+
+// Buffered output writer struct
+typedef struct out_buffer {
+    int file_descriptor;    // Descriptor receiving the output, or -1 to only collect in memory
+    std::string data;       // Bytes collected since the last flush
+    io_pipeline *pipeline;  // Pipeline whose writer thread takes the flushed bytes, or NULL to write them here
+} out_buffer;
+
+/**
+ * @brief Writes every collected byte to the output descriptor.
+ *
+ * The buffer keeps its capacity, so it is reused without reallocating. With a pipeline, the
+ * bytes are handed to its writer thread instead, and stay collected while the writer is behind.
+ *
+ * @param output  The output writer to flush.
+ */
+void out_flush(out_buffer &output);
+
+/**
+ * @brief Appends bytes to the output writer, flushing once `WRITE_BUFFER_SIZE` is reached.
+ *
+ * @param output  The output writer.
+ * @param bytes   The bytes to append.
+ */
+inline void out_write(
+    out_buffer &output,
+    const std::string_view &bytes
+) {
+    output.data.append(bytes.data(), bytes.length());
+
+    if (output.data.size() >= WRITE_BUFFER_SIZE && output.file_descriptor >= 0) out_flush(output);
+}
+
+/**
+ * @brief Appends a single byte to the output writer.
+ *
+ * @param output     The output writer.
+ * @param character  The byte to append.
+ */
+inline void out_write(
+    out_buffer &output,
+    const char &character
+) {
+    output.data.push_back(character);
+
+    if (output.data.size() >= WRITE_BUFFER_SIZE && output.file_descriptor >= 0) out_flush(output);
+}
+
+/**
+ * @brief Appends a run of identical bytes (e.g. space padding) to the output writer.
+ *
+ * @param output     The output writer.
+ * @param count      Number of bytes to append.
+ * @param character  The byte to repeat.
+ */
+inline void out_fill(
+    out_buffer &output,
+    const size_t &count,
+    const char &character
+) {
+    output.data.append(count, character);
+
+    if (output.data.size() >= WRITE_BUFFER_SIZE && output.file_descriptor >= 0) out_flush(output);
+}
+
+// Repeated fill glyph struct
+typedef struct fill_pattern {
+    alignas(64) char block[FILL_BLOCK_SIZE];  // Whole copies of the glyph, back to back
+    size_t glyph_length;                      // Number of bytes per glyph
+    size_t block_length;                      // Number of bytes of whole glyphs held in the block
+} fill_pattern;
+
+/**
+ * @brief Builds the pattern block of a fill glyph.
+ *
+ * @param glyph            The (possibly multi-byte) glyph to repeat, at most `FILL_BLOCK_SIZE` bytes long.
+ * @param max_glyph_count  Copies worth filling when runs are known to be short. Defaults to a full block.
+ *
+ * @return The pattern, holding as many whole copies of the glyph as fit in one block.
+ */
+fill_pattern make_fill_pattern(
+    const std::string_view &glyph,
+    const size_t &max_glyph_count = FILL_BLOCK_SIZE
+);
+
+/**
+ * @brief Appends a run of repeated glyphs (e.g. a border line) copied from a fill pattern.
+ *
+ * The run is copied a whole block at a time, so a run of n glyphs costs one memcpy per
+ * `FILL_BLOCK_SIZE` bytes instead of n appends. Single-byte runs such as space padding
+ * use `out_fill()`, whose `string::append(count, character)` already compiles to memset.
+ *
+ * @param target       The string to append to.
+ * @param pattern      The fill pattern of the glyph.
+ * @param glyph_count  Number of glyphs to append.
+ */
+inline void append_fill_run(
+    std::string &target,
+    const fill_pattern &pattern,
+    const size_t &glyph_count
+) {
+    size_t byte_count = glyph_count * pattern.glyph_length;
+
+    target.reserve(target.size() + byte_count);
+
+    for (; byte_count > pattern.block_length; byte_count -= pattern.block_length) target.append(pattern.block, pattern.block_length);
+
+    target.append(pattern.block, byte_count);
+}
+
+/**
+ * @brief Aligns a given string within a specified column width based on the desired alignment.
+ *
+ * This function takes a string and formats it within a given width, aligning it either 
+ * to the left, center, or right. It pads the string with spaces accordingly and returns 
+ * a pair containing the original column width and the formatted (aligned) string.
+ *
+ * @param string_to_align     The text content to align.
+ * @param tab_col_width       The width of the column the text should fit into.
+ * @param text_alignment      The alignment directive: "left", "center", or "right". Defaults to "left".
+ * 
+ * @return pair<size_t, string> A pair containing:
+ *                              - The column width (as a `size_t`)
+ *                              - The aligned string with space-padding as needed
+ */
+std::pair<size_t, std::string> align_text(
+    std::string_view string_to_align,
+    size_t tab_col_width,
+    std::string text_alignment = ALIGN_LEFT
+);
+
+// Table rendering options struct
+typedef struct tab_render_options {
+    bool headerless;                // Disable table header rendering
+    bool use_border;                // Enable table border rendering output
+    bool use_separator;             // Enable a horizontal line separator between header and body
+    std::string table_color;        // Color for the outer table border
+    std::string header_text_color;  // Text color used for header row
+    std::string body_text_color;    // Text color used for body rows
+    std::string header_bg_color;    // Background color for header row
+    std::string body_bg_color;      // Background color for body rows
+    std::string header_text_style;  // Text style for header row
+    std::string body_text_style;    // Text style for body rows
+    std::string header_text_align;  // Text aligmnet for header rows
+    std::string body_text_align;    // Text aligmnet for body rows
+    tab_border border_style;        // Border characters used for the table
+} tab_render_options;
+
+// Table theme preset struct, NULL members leave the matching option unchanged
+typedef struct tab_theme {
+    const char *name;                // Value of the --theme option
+    const tab_border *border_style;  // Border characters used for the table
+    int col_separator;               // Column delimiter, or -1 to keep the current one
+    const char *table_color;         // Color for the outer table border
+    const char *header_text_color;   // Text color used for header row
+    const char *body_text_color;     // Text color used for body rows
+    const char *header_bg_color;     // Background color for header row
+    const char *body_bg_color;       // Background color for body rows
+    const char *header_text_style;   // Text style for header row
+    const char *body_text_style;     // Text style for body rows
+    const char *header_text_align;   // Text aligmnet for header rows
+    const char *body_text_align;     // Text aligmnet for body rows
+} tab_theme;
+
+// Themes selectable with --theme
+static constexpr tab_theme THEMES[] = {
+    { "matrix", &HEAVY_BORDER_STYLE, -1, GREEN, GREEN, GREEN, NULL, NULL, BOLD, BOLD, ALIGN_CENTER, NULL },
+    { "mecha", &DOUBLE_BORDER_STYLE, -1, NULL, NULL, NULL, BG_CYAN, BG_MAGENTA, BOLD, UNDERLINE, ALIGN_CENTER, ALIGN_CENTER },
+    { "myth", &DOUBLE_BORDER_STYLE, -1, RED, WHITE, MAGENTA, BG_RED, BG_BLACK, BOLD, NULL, ALIGN_CENTER, ALIGN_CENTER },
+    { "retro", &STAR_BORDER_STYLE, -1, NULL, NULL, NULL, BG_RED, BG_YELLOW, BOLD, ITALIC, ALIGN_CENTER, ALIGN_CENTER },
+    { "sticky", &DOUBLE_BORDER_STYLE, TAB, NULL, NULL, NULL, BG_GREEN, BG_YELLOW, BOLD, UNDERLINE, ALIGN_CENTER, NULL }
+};
+
+// Text alignment kinds
+typedef enum text_alignment {
+    TEXT_ALIGN_LEFT,
+    TEXT_ALIGN_CENTER,
+    TEXT_ALIGN_RIGHT
+} text_alignment;
+
+struct render_plan;
+
+// Renderer of one body line, specialized by compile_render_plan() for the borders, styles and alignment of a plan,
+// returning false without writing anything when a cell is wider than its column
+typedef bool (*line_kernel)(
+    out_buffer &output,
+    const std::string_view *tab_row,
+    const size_t *cell_widths,
+    const size_t &cell_count,
+    const render_plan &plan
+);
+
+// Compiled render plan struct
+typedef struct render_plan {
+    const tab_render_options *options;             // The configuration the plan was compiled from
+    size_t max_col_count;                          // The total number of columns in the table
+    std::vector<size_t> col_width;                 // The final width of each column (includes padding)
+    std::vector<size_t> col_content_width;         // The widest content shown in each column, wider cells are truncated
+    std::vector<text_alignment> header_col_align;  // Alignment of each header cell
+    std::vector<text_alignment> body_col_align;    // Alignment of each body cell
+    std::string row_prefix;                        // Bytes opening every row (left border)
+    std::string header_cell_prefix;                // Style, background and text color opening a header cell
+    std::string body_cell_prefix;                  // Style, background and text color opening a body cell
+    std::string cell_suffix;                       // Bytes closing every cell (reset, border color, vertical line)
+    std::string top_border;                        // Rendered top border line, empty without borders
+    std::string separator_border;                  // Rendered header-body separator line, empty without borders
+    std::string bottom_border;                     // Rendered bottom border line, empty without borders
+    bool wrap_cells;                               // Whether wider cells continue on more lines instead of being truncated
+    line_kernel body_line_kernel;                  // Renderer of the body lines that fit, NULL for mixed alignments
+    size_t body_line_bytes;                        // Bytes of a body line around the cell contents (borders, styles and padding)
+} render_plan;
+
+/**
+ * @brief Maps an alignment directive to its alignment kind.
+ *
+ * @param text_align  The alignment directive: "left", "center", or "right".
+ *
+ * @return The matching alignment kind, left for anything else.
+ */
+text_alignment get_text_alignment(const std::string &text_align);
+
+/**
+ * @brief Returns the width of the terminal the table is written to.
+ *
+ * @return The number of terminal columns of stdout, else of `$COLUMNS`, or 0 if unknown.
+ */
+size_t get_terminal_width();
+
+/**
+ * @brief Clamps the column content widths to the column and table width limits.
+ *
+ * Columns wider than `max_col_width` are narrowed to it. If the table is then still wider
+ * than `max_table_width`, every column is narrowed to the largest common cap that fits,
+ * so narrow columns keep their width and only the widest ones give up space. A clamped
+ * column keeps at least one column for the ellipsis, even if the table then overflows.
+ *
+ * @param col_content_width  The content width of each column (excludes padding), clamped in place.
+ * @param max_col_width      The widest content of a column, 0 for no limit.
+ * @param max_table_width    The widest rendered table, borders and padding included, 0 for no limit.
+ * @param col_padding        Number of spaces added to each column width.
+ * @param use_border         Whether the table is drawn with vertical borders.
+ */
+void clamp_col_widths(
+    std::vector<size_t> &col_content_width,
+    const size_t &max_col_width,
+    const size_t &max_table_width,
+    const int &col_padding,
+    const bool &use_border
+);
+
+// Layouts of a table wider than the terminal, chosen by --fit
+enum fit_layout {
+    FIT_NONE,    // The table keeps its width
+    FIT_AUTO,    // The layout is chosen from the column widths
+    FIT_SHRINK,  // The widest columns are narrowed, their cells truncated with an ellipsis
+    FIT_WRAP,    // The widest columns are narrowed, their cells continuing on more lines
+    FIT_STACK    // The columns are split into table sections written one below the other
+};
+
+// Named fit layout struct
+typedef struct fit_entry {
+    const char *name;   // Value of the --fit option
+    fit_layout layout;  // The layout
+} fit_entry;
+
+// Layouts accepted by --fit
+static constexpr fit_entry FIT_LAYOUTS[] = {
+    { "auto", FIT_AUTO }, { "shrink", FIT_SHRINK }, { "stack", FIT_STACK }, { "wrap", FIT_WRAP }
+};
+
+/**
+ * @brief Chooses how a table is fitted into a width from its column widths alone.
+ *
+ * The table is shrunk while that hides at most 1/`FIT_SHRINK_LOSS` of its content, else
+ * wrapped while every column keeps `FIT_WRAP_MIN_WIDTH` columns (or its whole width when
+ * narrower), else stacked. The choice
+ * looks at every column once, so it costs nothing next to the parse.
+ *
+ * @param col_content_width  The content width of each column (excludes padding).
+ * @param max_table_width    The widest rendered table, borders and padding included, 0 for no limit.
+ * @param col_padding        Number of spaces added to each column width.
+ * @param use_border         Whether the table is drawn with vertical borders.
+ *
+ * @return `FIT_NONE` if the table already fits, else `FIT_SHRINK`, `FIT_WRAP` or `FIT_STACK`.
+ */
+fit_layout choose_fit_layout(
+    const std::vector<size_t> &col_content_width,
+    const size_t &max_table_width,
+    const int &col_padding,
+    const bool &use_border
+);
+
+/**
+ * @brief Splits the columns into table sections that each fit into a width.
+ *
+ * Columns are taken from left to right while they fit. The first column names the rows,
+ * so it is repeated at the start of every section as long as it takes at most a third
+ * of the width. A column too wide on its own gets a section of its own, to be clamped.
+ *
+ * @param col_content_width  The content width of each column (excludes padding).
+ * @param max_table_width    The widest rendered section, borders and padding included, 0 for no limit.
+ * @param col_padding        Number of spaces added to each column width.
+ * @param use_border         Whether the table is drawn with vertical borders.
+ * @param sections           Receives the columns of each section, in order.
+ */
+void get_stack_sections(
+    const std::vector<size_t> &col_content_width,
+    const size_t &max_table_width,
+    const int &col_padding,
+    const bool &use_border,
+    std::vector<std::vector<size_t>> &sections
+);
+
+/**
+ * @brief Compiles the rendering configuration into a render plan for the final column widths.
+ *
+ * The ANSI sequences wrapped around every cell and row are joined once here, and the
+ * alignments are resolved per column, so rendering a cell only copies bytes and pads.
+ * The border lines are rendered here too, as they only depend on the column widths.
+ * A body line kernel is picked once for the plan, instantiated for whether the rows have
+ * borders, whether the cells are styled, and the alignment shared by every column, so the
+ * body rows are rendered without testing any of these per cell.
+ *
+ * @param render_options     The styling and border configuration.
+ * @param col_content_width  The content width of each column (excludes padding).
+ * @param col_padding        Number of spaces added to each column width.
+ *
+ * @return The compiled render plan.
+ */
+render_plan compile_render_plan(
+    const tab_render_options &render_options,
+    const std::vector<size_t> &col_content_width,
+    const int &col_padding
+);
+
+/**
+ * @brief Reads everything left on a file descriptor into one contiguous buffer.
+ *
+ * @param file_descriptor  The descriptor to read from.
+ * @param input            Buffer receiving the bytes, resized to the number of bytes read.
+ */
+void read_all(
+    const int &file_descriptor,
+    std::vector<char> &input
+);
+
+/**
+ * @brief Maps a regular file input into memory so it can be tokenized in place.
+ *
+ * Pipes, terminals, and files whose size is unknown (e.g. under /proc) are not mapped
+ * and must be read instead.
+ *
+ * @param file_descriptor  The input descriptor.
+ * @param mapping_length   Receives the length of the mapping.
+ *
+ * @return Pointer to the mapped input, or NULL if the input cannot be mapped.
+ */
+const char *map_input(
+    const int &file_descriptor,
+    size_t &mapping_length
+);
+
+/**
+ * @brief Releases an input mapped by `map_input()`.
+ *
+ * @param mapping         Pointer returned by `map_input()`.
+ * @param mapping_length  Length returned by `map_input()`.
+ */
+void unmap_input(
+    const char *mapping,
+    const size_t &mapping_length
+);
+
+// Compression formats of the input, recognised by their magic bytes
+typedef enum input_compression {
+    COMPRESSION_NONE,  // Plain text
+    COMPRESSION_GZIP,  // gzip members (.gz), decoded with zlib when built with TABSTIJL_ZLIB
+    COMPRESSION_ZSTD   // Zstandard frames (.zst), decoded with libzstd when built with TABSTIJL_ZSTD
+} input_compression;
+
+/**
+ * @brief Detects a compressed input from its first bytes, without consuming them.
+ *
+ * Only regular files are checked, as the bytes of a pipe cannot be read back.
+ *
+ * @param file_descriptor  The input descriptor.
+ *
+ * @return The compression format of the input, `COMPRESSION_NONE` for plain text.
+ */
+input_compression detect_compression(const int &file_descriptor);
+
+/**
+ * @brief Decompresses an input block by block, handing every block to a callback.
+ *
+ * The callback gets up to `READ_BLOCK_SIZE` decompressed bytes at a time, so it can feed
+ * them straight into `parse_block()`. With `use_thread`, decompression runs on a background
+ * thread through a double buffer: one block is decompressed while the callback consumes
+ * the other. Concatenated gzip members and zstd frames are decoded in turn, as `zcat` does.
+ *
+ * @param file_descriptor  The compressed input descriptor.
+ * @param compression      The compression format, from `detect_compression()`.
+ * @param on_block         Callback receiving each decompressed block, returning `false` to stop early.
+ * @param use_thread       Whether to decompress on a background thread.
+ * @param error            Receives the reason of a failure, left unchanged on success.
+ *
+ * @return `false` if the input is corrupt or truncated, or the format was not built in,
+ *         `true` otherwise.
+ */
+bool decode_input(
+    const int &file_descriptor,
+    const input_compression &compression,
+    const std::function<bool(const char *, size_t)> &on_block,
+    const bool &use_thread,
+    std::string &error
+);
+
+/**
+ * @brief Runs a number of independent tasks on up to `jobs` threads.
+ *
+ * Tasks are handed out in increasing order; the calling thread takes part in the work.
+ *
+ * @param task_count  Number of tasks to run.
+ * @param jobs        Maximum number of threads, including the calling thread.
+ * @param task        Callback running one task, given its index.
+ */
+void run_parallel(
+    const size_t &task_count,
+    const size_t &jobs,
+    const std::function<void(size_t)> &task
+);
+
+/**
+ * @brief Widens the column widths so that every cell of a row fits.
+ *
+ * @param tab_col_width  The maximum width of each column seen so far, grown as needed.
+ * @param cell_widths    The display width of each cell of the row being measured.
+ * @param cell_count     Number of cells in the row.
+ */
+void update_col_width(
+    std::vector<size_t> &tab_col_width,
+    const size_t *cell_widths,
+    const size_t &cell_count
+);
+
+/**
+ * @brief Renders the styled and padded content of one cell, without the border that follows it.
+ *
+ * The cell takes exactly the width of its column, so it can also overwrite a cell already
+ * on the screen. A cell wider than its column content width is truncated with an ellipsis.
+ *
+ * @param output      The output writer receiving the rendered cell.
+ * @param tab_cell    The cell text.
+ * @param cell_width  The display width of the cell text.
+ * @param col_index   The column of the cell.
+ * @param header_row  Whether the cell belongs to the header row.
+ * @param plan        The compiled render plan.
+ */
+void render_cell(
+    out_buffer &output,
+    std::string_view tab_cell,
+    size_t cell_width,
+    const size_t &col_index,
+    const bool &header_row,
+    const render_plan &plan
+);
+
+/**
+ * @brief Renders a single table row, including the borders that surround it.
+ *
+ * The top border is drawn before the first row, and the header-body separator after it
+ * when a header is shown. Cells missing from ragged rows are rendered empty, and cells
+ * wider than their column content width are truncated with an ellipsis. With `wrap_cells`
+ * in the plan they continue on the next lines of the row instead, broken after a space
+ * when the line has one.
+ *
+ * @param output       The output writer receiving the rendered row.
+ * @param tab_row      The cells of the row.
+ * @param cell_widths  The display width of each cell of the row.
+ * @param cell_count   Number of cells in the row.
+ * @param first_line   Whether this is the first row of the table.
+ * @param plan         The compiled render plan.
+ */
+void render_row(
+    out_buffer &output,
+    const std::string_view *tab_row,
+    const size_t *cell_widths,
+    const size_t &cell_count,
+    const bool &first_line,
+    const render_plan &plan
+);
+
+/**
+ * @brief Renders the bottom border that closes the table, if borders are enabled.
+ *
+ * @param output  The output writer receiving the border.
+ * @param plan    The compiled render plan.
+ */
+void render_bottom_border(
+    out_buffer &output,
+    const render_plan &plan
+);
+
+// Output formats of the table
+typedef enum output_format {
+    FORMAT_PRETTY,    // Styled table with borders (the default)
+    FORMAT_TSV,       // Tab separated values
+    FORMAT_CSV,       // Comma separated values (RFC 4180 quoting)
+    FORMAT_JSON,      // JSON array of objects keyed by the header, or of arrays without a header
+    FORMAT_MARKDOWN   // Markdown pipe table
+} output_format;
+
+// Named output format struct
+typedef struct format_entry {
+    const char *name;      // Value of the --format option
+    output_format format;  // The output format
+} format_entry;
+
+// Formats accepted by --format and --tee
+static constexpr format_entry OUTPUT_FORMATS[] = {
+    { "csv", FORMAT_CSV }, { "json", FORMAT_JSON }, { "markdown", FORMAT_MARKDOWN }, { "pretty", FORMAT_PRETTY }, { "tsv", FORMAT_TSV }
+};
+
+// Table writer struct, writing the rows of one table in one output format
+typedef struct table_writer {
+    output_format format;                // The output format
+    out_buffer *output;                  // The output writer receiving the table
+    const render_plan *plan;             // The compiled render plan (pretty format only)
+    bool headerless;                     // Whether the first row is a body row
+    size_t max_col_count;                // The total number of columns in the table (markdown format only)
+    text_alignment col_align;            // Alignment of the markdown columns
+    const std::string_view *header_row;  // The header cells naming the JSON members, or NULL
+    size_t header_cell_count;            // Number of header cells
+    size_t row_index;                    // Index of the next row
+    size_t record_count;                 // Number of JSON records written
+} table_writer;
+
+/**
+ * @brief Writes a cell with the characters special to an output format escaped.
+ *
+ * Unescaped runs of bytes are copied as a whole, so no temporary string is built.
+ *
+ * @param output    The output writer.
+ * @param tab_cell  The cell to write.
+ * @param format    The output format, which decides the escaping.
+ */
+void write_escaped_cell(
+    out_buffer &output,
+    const std::string_view &tab_cell,
+    const output_format &format
+);
+
+/**
+ * @brief Writes one markdown table line, padded with empty cells to the column count.
+ *
+ * @param output         The output writer.
+ * @param tab_row        The cells of the line, or NULL for an empty line.
+ * @param cell_count     Number of cells in the line.
+ * @param max_col_count  The total number of columns in the table.
+ */
+void write_markdown_line(
+    out_buffer &output,
+    const std::string_view *tab_row,
+    const size_t &cell_count,
+    const size_t &max_col_count
+);
+
+/**
+ * @brief Writes what opens the table in the output format of a writer.
+ *
+ * @param writer  The table writer.
+ */
+void write_table_begin(table_writer &writer);
+
+/**
+ * @brief Writes one row of the table in the output format of a writer.
+ *
+ * The pretty format renders the row with `render_row()`. The other formats only copy and
+ * escape the cells, with no ANSI sequences, borders or padding. The markdown header and
+ * delimiter lines are written with the first row, an empty header being made up when the
+ * table is headerless. The JSON header row is not written, it names the members instead.
+ *
+ * @param writer       The table writer.
+ * @param tab_row      The cells of the row.
+ * @param cell_widths  The display width of each cell of the row (pretty format only).
+ * @param cell_count   Number of cells in the row.
+ */
+void write_table_row(
+    table_writer &writer,
+    const std::string_view *tab_row,
+    const size_t *cell_widths,
+    const size_t &cell_count
+);
+
+/**
+ * @brief Writes what closes the table in the output format of a writer.
+ *
+ * @param writer  The table writer.
+ */
+void write_table_end(table_writer &writer);
+
+/**
+ * @brief Writes the --footer rows after the body rows of a table.
+ *
+ * The pretty format draws the header-body separator line above the footer rows.
+ *
+ * @param writer        The table writer.
+ * @param footer_store  The store holding the footer rows.
+ */
+void write_table_footer(
+    table_writer &writer,
+    const tab_store &footer_store
+);
+
+/**
+ * @brief Tokenizes an in-memory input on several threads into one cell store.
+ *
+ * The input is split into `jobs` chunks at newline boundaries, which are row boundaries
+ * for every separator. Each chunk is tokenized into its own store by a worker, and only
+ * the first chunk applies the first line rules, and cells are kept as views into the input,
+ * which must outlive the store. The --hdata header replaces the first row of the first
+ * non-empty chunk. The chunk stores are then copied into `cmdout_tab_data`
+ * in order while each worker computes the column widths of its chunk, and the partial
+ * widths are merged by taking the maximum of every column.
+ *
+ * @param input                 Pointer to the whole input.
+ * @param input_length          Number of bytes in the input.
+ * @param parser_template       Tokenizer settings (separator and first line handling).
+ * @param usrinput_header_data  The header data replacing the first row, or empty.
+ * @param jobs                  Number of threads to use.
+ * @param cmdout_tab_data       The store receiving every row, in input order.
+ * @param tab_col_width         Receives the maximum width of each column (without padding).
+ */
+void load_table_parallel(
+    const char *input,
+    const size_t &input_length,
+    const tab_parser &parser_template,
+    const std::vector<std::string> &usrinput_header_data,
+    const size_t &jobs,
+    tab_store &cmdout_tab_data,
+    std::vector<size_t> &tab_col_width
+);
+
+/**
+ * @brief Renders every row of a store on several threads, writing the output in order.
+ *
+ * Rows are rendered in batches of `RENDER_BATCH_ROWS` into per-task buffers. After each
+ * round of `jobs` batches the buffers are written in row order, which keeps the output
+ * byte-identical to the sequential renderer while bounding the memory of the buffers.
+ *
+ * @param output           The output writer receiving the table.
+ * @param cmdout_tab_data  The store holding every row.
+ * @param plan             The compiled render plan.
+ * @param jobs             Number of threads to use.
+ */
+void render_table_parallel(
+    out_buffer &output,
+    const tab_store &cmdout_tab_data,
+    const render_plan &plan,
+    const size_t &jobs
+);
+
+// Key kinds of --sort
+enum sort_kind {
+    SORT_LEX,  // Byte-wise comparison of the cells
+    SORT_NUM   // Comparison of the leading numbers of the cells
+};
+
+// Sort settings struct
+typedef struct sort_spec {
+    size_t sort_col;   // Column the rows are sorted by (0-based)
+    sort_kind kind;    // How the cells of the column compare
+    bool descending;   // Whether the largest cells come first
+} sort_spec;
+
+// Precomputed sort key of one row, so that comparisons stay in one contiguous array
+typedef struct sort_key {
+    double number;     // Leading number of the cell for numeric sorts, NaN if there is none
+    uint64_t prefix;   // First eight bytes of the cell, big-endian and zero padded, for text sorts
+    size_t row_index;  // Row of the store
+} sort_key;
+
+/**
+ * @brief Computes the sort key of a row.
+ *
+ * @param store      The cell store.
+ * @param row_index  The row.
+ * @param spec       The sort settings.
+ *
+ * @return The sort key.
+ */
+sort_key make_sort_key(
+    const tab_store &store,
+    const size_t &row_index,
+    const sort_spec &spec
+);
+
+/**
+ * @brief Reorders the rows of a store, keeping only the given rows.
+ *
+ * Only the cell views and widths are moved, the cell bytes stay where they are.
+ *
+ * @param store      The cell store.
+ * @param row_order  The rows to keep, in their new order.
+ */
+void store_reorder_rows(
+    tab_store &store,
+    const std::vector<size_t> &row_order
+);
+
+/**
+ * @brief Sorts the body rows of a store, then keeps the first and last rows if asked.
+ *
+ * The rows are sorted as an index of precomputed keys, which `store_reorder_rows()` then
+ * applies in one pass. Sorting is stable, so equal rows keep their input order. Large
+ * tables are split into `jobs` runs sorted on their own threads, then merged pairwise.
+ *
+ * @param store             The cell store.
+ * @param spec              The sort settings.
+ * @param header_row_count  Number of leading rows kept in place (the header).
+ * @param head_rows         Number of first sorted rows kept, 0 for no limit.
+ * @param tail_rows         Number of last sorted rows kept, 0 for no limit.
+ * @param jobs              Maximum number of threads.
+ */
+void sort_table(
+    tab_store &store,
+    const sort_spec &spec,
+    const size_t &header_row_count,
+    const size_t &head_rows,
+    const size_t &tail_rows,
+    const size_t &jobs
+);
+
+// Aggregates of the --footer rows
+enum footer_aggregate {
+    FOOTER_SUM,  // Sum of the numbers of a column
+    FOOTER_AVG,  // Mean of the numbers of a column
+    FOOTER_MIN,  // Smallest number of a column
+    FOOTER_MAX   // Largest number of a column
+};
+
+// Named footer aggregate struct
+typedef struct footer_entry {
+    const char *name;            // Value of the --footer option, also labeling the footer row
+    footer_aggregate aggregate;  // The aggregate
+} footer_entry;
+
+// Aggregates accepted by --footer
+static constexpr footer_entry FOOTER_AGGREGATES[] = {
+    { "avg", FOOTER_AVG }, { "max", FOOTER_MAX }, { "min", FOOTER_MIN }, { "sum", FOOTER_SUM }
+};
+
+/**
+ * @brief Finds the numeric kind of every column from the numbers cached by the store.
+ *
+ * A column is numeric when every non-empty body cell is a number of a compatible kind.
+ * Integers and decimals make a decimal column. Sizes also take plain numbers (e.g. the
+ * "0" that 'du -h' writes for empty directories), while percentages only take percentages.
+ *
+ * @param store           The cell store, which must parse numbers.
+ * @param first_body_row  Index of the first body row: 1 below a header, else 0.
+ * @param col_kinds       Receives the kind of each column, `NUMBER_NONE` for the text columns.
+ */
+void get_col_kinds(
+    const tab_store &store,
+    const size_t &first_body_row,
+    std::vector<number_kind> &col_kinds
+);
+
+/**
+ * @brief Right-aligns the header and body cells of the numeric columns of a render plan.
+ *
+ * The body line kernel of the plan is picked again, as the columns may no longer share one alignment.
+ *
+ * @param plan       The compiled render plan.
+ * @param col_kinds  The kind of each column, from `get_col_kinds()`.
+ */
+void align_numeric_cols(
+    render_plan &plan,
+    const std::vector<number_kind> &col_kinds
+);
+
+/**
+ * @brief Formats a number as the cells of a column of the given kind.
+ *
+ * Sizes are scaled to the largest unit below them, with one decimal under 10 as in the
+ * `-h` output of coreutils. Other numbers keep the given number of decimals.
+ *
+ * @param value     The number, sizes in bytes.
+ * @param kind      The kind of the column.
+ * @param decimals  Number of digits after the decimal point.
+ *
+ * @return The formatted number.
+ */
+std::string format_number(
+    const double &value,
+    const number_kind &kind,
+    const size_t &decimals
+);
+
+/**
+ * @brief Computes the --footer rows of the numeric columns.
+ *
+ * The sums, counts and extremes of every column are reduced in one pass over the cached
+ * numbers of the body rows, with no cell parsed again. Each aggregate makes one row holding
+ * the value of every numeric column, labeled with the aggregate name in the first column,
+ * ahead of its value when that column is numeric. Averages get one more decimal than the
+ * column.
+ *
+ * @param store           The cell store, which must parse numbers.
+ * @param first_body_row  Index of the first body row: 1 below a header, else 0.
+ * @param col_kinds       The kind of each column, from `get_col_kinds()`.
+ * @param aggregates      The aggregates, one footer row each.
+ * @param footer_rows     Receives the footer rows, empty if no column is numeric.
+ */
+void get_footer_rows(
+    const tab_store &store,
+    const size_t &first_body_row,
+    const std::vector<number_kind> &col_kinds,
+    const std::vector<footer_aggregate> &aggregates,
+    std::vector<std::vector<std::string>> &footer_rows
+);
+
+/**
+ * @brief Finds a border style by its --border-style name.
+ *
+ * @param style_name  The border style: "double", "heavy", or "star".
+ *
+ * @return The border style, or NULL if no style has the given name.
+ */
+const tab_border *find_border_style(const std::string_view &style_name);
+
+/**
+ * @brief Applies a predefined theme to the rendering configuration.
+ *
+ * @param theme_name      The theme: "matrix", "mecha", "myth", "retro", or "sticky".
+ * @param render_options  The styling and border configuration, overwritten by the theme.
+ * @param col_separator   The column delimiter, overwritten by themes that set one.
+ *
+ * @return `false` if no theme has the given name, `true` otherwise.
+ */
+bool apply_theme(
+    const std::string_view &theme_name,
+    tab_render_options &render_options,
+    char &col_separator
+);
+
+// --------------------------------------------------
+// Renderer
+// --------------------------------------------------
+
+/**
+ * @brief Builds the default rendering options: a single-line border with a header separator,
+ *        left-aligned text and no colors or styles.
+ *
+ * @return The default rendering options.
+ */
+tab_render_options default_render_options();
+
+/**
+ * @brief Formats many in-memory tables with one configuration.
+ *
+ * The styles, borders, alignments, padding and width limits are set once, then each call
+ * to `render()` or `render_text()` lays out one table and writes it into a buffer given by
+ * the caller. The buffer, the cell store, the tokenizer and the column widths keep their
+ * capacity between tables, and the render plan is only compiled again when the column
+ * widths change, so rendering a stream of similar tables does not reallocate.
+ *
+ * Example:
+ *
+ *     tabstijl::Renderer renderer;
+ *     string output;
+ *
+ *     renderer.set_theme("matrix");
+ *     renderer.render_text("name size\nmain.cpp 4096\n", output);
+ */
+class Renderer {
+public:
+    Renderer();
+
+    // The render plan points to the options of its renderer
+    Renderer(const Renderer &) = delete;
+    Renderer &operator=(const Renderer &) = delete;
+
+    /**
+     * @brief Replaces the styling and border configuration.
+     *
+     * @param render_options  The styling and border configuration.
+     */
+    void set_render_options(const tab_render_options &render_options);
+
+    /**
+     * @brief Gets the styling and border configuration.
+     *
+     * @return The styling and border configuration.
+     */
+    const tab_render_options &get_render_options() const;
+
+    /**
+     * @brief Applies a theme preset, as with --theme.
+     *
+     * @param theme_name  The name of the theme.
+     *
+     * @return `false` if no theme has that name.
+     */
+    bool set_theme(const std::string_view &theme_name);
+
+    /**
+     * @brief Selects a border style, as with --border-style.
+     *
+     * @param style_name  The name of the border style.
+     *
+     * @return `false` if no border style has that name.
+     */
+    bool set_border_style(const std::string_view &style_name);
+
+    /**
+     * @brief Sets the number of spaces around each cell, as with --padding.
+     *
+     * @param col_padding  Number of spaces added to each column width.
+     */
+    void set_padding(const int &col_padding);
+
+    /**
+     * @brief Sets the column separator used by `render_text()`, as with --separator.
+     *
+     * @param col_separator  The column delimiter (`SPACE`, `TAB`, `NEWLINE` or `VOID` for every whitespace).
+     */
+    void set_separator(const char &col_separator);
+
+    /**
+     * @brief Sets the output format, as with --format.
+     *
+     * @param format  The output format.
+     */
+    void set_format(const output_format &format);
+
+    /**
+     * @brief Sets the width limits, as with --max-col-width and --max-table-width.
+     *
+     * @param max_col_width    Widest content of a column, 0 for no limit.
+     * @param max_table_width  Widest rendered table, 0 for no limit.
+     */
+    void set_width_limits(
+        const size_t &max_col_width,
+        const size_t &max_table_width
+    );
+
+    /**
+     * @brief Renders a table given as rows of cells.
+     *
+     * The cells are not copied, they are only read during the call.
+     *
+     * @param tab_rows  The rows of the table, the first one being the header unless headerless.
+     * @param output    Receives the rendered table, replacing its contents and keeping its capacity.
+     */
+    void render(
+        const std::vector<std::vector<std::string>> &tab_rows,
+        std::string &output
+    );
+
+    /**
+     * @brief Tokenizes a text as the command-line tool does and renders it as a table.
+     *
+     * The cells are views into the text, which is only read during the call.
+     *
+     * @param text    The raw text, one row per line.
+     * @param output  Receives the rendered table, replacing its contents and keeping its capacity.
+     */
+    void render_text(
+        const std::string_view &text,
+        std::string &output
+    );
+
+private:
+    /**
+     * @brief Lays out the stored table and writes it to the output.
+     *
+     * @param output  Receives the rendered table.
+     */
+    void render_store(std::string &output);
+
+    tab_render_options render_options;  // Styling and border configuration consumed by the render plan
+    char col_separator;                 // Column delimiter of render_text()
+    int col_padding;                    // Number of spaces added on each side of a table cell value
+    output_format format;               // Format of the rendered tables
+    size_t max_col_width;               // Widest content of a column, 0 for no limit
+    size_t max_table_width;             // Widest rendered table, 0 for no limit
+    tab_parser parser;                  // Tokenizer of render_text(), reset for every text
+    tab_store store;                    // Cells of the table being rendered
+    std::vector<size_t> col_widths;     // Content width of each column of the table being rendered
+    render_plan plan;                   // Render plan of the last table
+    bool has_plan;                      // Whether the plan matches the configuration
+};
+
+}  // namespace tabstijl
+
+#endif  // TABSTIJL_HPP
@@ -0,0 +1,200 @@
+// MIT License
+
+// Copyright (c) 2025 Naufal Hanif
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file tabstijl_cli.hpp
+ *
+ * @brief Declares the parts of libtabstijl used only by the tabstijl command-line tool.
+ *
+ * These are the --stats counters and timers, and the --stream and --live drivers, which
+ * read and write the process descriptors and report errors on stderr. They are not part of
+ * the installed `tabstijl.hpp`.
+ *
+ * @author Naufal Hanif
+ * @date 2025
+ */
+
+#ifndef TABSTIJL_CLI_HPP
+#define TABSTIJL_CLI_HPP
+
+// --------------------------------------------------
+// Library Includes
+// --------------------------------------------------
+
+#include "tabstijl.hpp"
+
+// --------------------------------------------------
+// Standard Library Includes
+// --------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+
+namespace tabstijl {
+
+// I/O pipeline of --live and --stream
+static constexpr size_t PIPELINE_BACKLOG_LIMIT = 64 << 20;  // Rendered bytes held while stdout is blocked before the renderer waits
+
+// Live mode
+static constexpr int LIVE_SAMPLE_TIMEOUT = 100;  // Milliseconds of input silence that end the sampling early
+
+// Number of table bytes read from the input and written to the outputs, reported by --stats
+extern std::atomic<size_t> input_byte_count;
+extern std::atomic<size_t> output_byte_count;
+
+// Phases timed by --stats
+enum stats_phase_id {
+    PHASE_OPTIONS,  // Option parsing
+    PHASE_PARSE,    // Reading and tokenizing the input
+    PHASE_SORT,     // Sorting the rows with --sort
+    PHASE_WIDTHS,   // Measuring the column widths and compiling the render plan
+    PHASE_RENDER,   // Rendering and writing the table
+    PHASE_COUNT     // Number of phases
+};
+
+// Names of the phases in the --stats report
+static constexpr const char *STATS_PHASE_NAMES[PHASE_COUNT] = { "options", "parse", "sort", "widths", "render" };
+
+// Phase boundary timestamp struct
+typedef struct stats_clock {
+    std::chrono::steady_clock::time_point wall;  // Wall clock time
+    double cpu_seconds;                          // CPU time used so far by every thread of the process
+} stats_clock;
+
+// Run statistics struct, reported by --stats
+typedef struct tab_stats {
+    double wall_seconds[PHASE_COUNT];  // Wall clock time spent in each phase
+    double cpu_seconds[PHASE_COUNT];   // CPU time spent in each phase
+    stats_clock phase_start;           // Start of the running phase
+    size_t row_count;                  // Number of table rows, header included
+    size_t cell_count;                 // Number of table cells
+    size_t max_col_count;              // Maximum number of cells in one row
+} tab_stats;
+
+/**
+ * @brief Takes a phase boundary timestamp.
+ *
+ * Both clocks are served by the vDSO, so a timestamp costs no system call.
+ *
+ * @return The current wall clock and process CPU times.
+ */
+stats_clock stats_now();
+
+/**
+ * @brief Charges the time since the start of the running phase to `phase`, then starts the next phase.
+ *
+ * @param stats  The run statistics.
+ * @param phase  The phase that just ended.
+ */
+void stats_end_phase(
+    tab_stats &stats,
+    const stats_phase_id &phase
+);
+
+/**
+ * @brief Renders the input as a table in two passes while holding only one row in memory.
+ *
+ * The first pass tokenizes the input to find the column widths and copies the raw bytes
+ * to a temporary spill file. When the input is itself a regular file it is rewound instead
+ * of spilled. The second pass tokenizes the spilled bytes again and renders each row as soon
+ * as it is complete, so peak memory depends on the column count rather than the row count.
+ * The first pass reads on a reader thread and the second pass writes on a writer thread.
+ *
+ * @param input_fd              The input descriptor (stdin or the --input file).
+ * @param parser_template       Tokenizer settings (separator and first line handling).
+ * @param usrinput_header_data  The header data from --hdata, replacing the first row.
+ * @param col_padding           Number of spaces added to each column width.
+ * @param max_col_width         The widest content of a column, 0 for no limit.
+ * @param max_table_width       The widest rendered table, 0 for no limit.
+ * @param render_options        The styling and border configuration.
+ * @param stats                 The run statistics, the first pass being timed as the parse phase.
+ *
+ * @return The process exit status.
+ */
+int stream_table(
+    const int &input_fd,
+    const tab_parser &parser_template,
+    const std::vector<std::string> &usrinput_header_data,
+    const int &col_padding,
+    const size_t &max_col_width,
+    const size_t &max_table_width,
+    const tab_render_options &render_options,
+    tab_stats &stats
+);
+
+/**
+ * @brief Fits a row into fixed column widths for live rendering.
+ *
+ * Cells beyond the last fixed column are joined into the last column. Cells wider than
+ * their column content width are left whole, `render_row()` truncates them.
+ *
+ * @param tab_row            The row to fit, modified in place.
+ * @param col_content_width  The fixed content width (excluding padding) of each column.
+ * @param joined_cell        Owned storage for a last cell joined from overflowing cells.
+ */
+void fit_live_row(
+    std::vector<std::string_view> &tab_row,
+    const std::vector<size_t> &col_content_width,
+    std::string &joined_cell
+);
+
+/**
+ * @brief Renders the input as a table row by row as soon as each newline arrives.
+ *
+ * Column widths are fixed from the first `sample_row_count` rows, or earlier when the
+ * input stays silent for `LIVE_SAMPLE_TIMEOUT` milliseconds, and `col_width_hints` take
+ * precedence over the sampled widths. After that, every row is fitted to the fixed widths
+ * and rendered immediately, which suits never-ending inputs such as `tail -f`.
+ *
+ * The input is read on a reader thread and the output written on a writer thread, so a
+ * blocked stdout holds back up to `PIPELINE_BACKLOG_LIMIT` rendered bytes before the input
+ * stops being read, and the upstream command keeps running meanwhile.
+ *
+ * @param input_fd              The input descriptor (stdin or the --input file).
+ * @param parser_template       Tokenizer settings (separator and first line handling).
+ * @param usrinput_header_data  The header data from --hdata, replacing the first row.
+ * @param col_padding           Number of spaces added to each column width.
+ * @param sample_row_count      Number of rows sampled before the widths are fixed.
+ * @param col_width_hints       Content widths given with --col-width, per column.
+ * @param max_col_width         The widest content of a column, 0 for no limit.
+ * @param max_table_width       The widest rendered table, 0 for no limit.
+ * @param render_options        The styling and border configuration.
+ * @param stats                 The run statistics, the whole run being timed as the render phase.
+ *
+ * @return The process exit status.
+ */
+int live_table(
+    const int &input_fd,
+    const tab_parser &parser_template,
+    const std::vector<std::string> &usrinput_header_data,
+    const int &col_padding,
+    const size_t &sample_row_count,
+    const std::vector<size_t> &col_width_hints,
+    const size_t &max_col_width,
+    const size_t &max_table_width,
+    const tab_render_options &render_options,
+    tab_stats &stats
+);
+
+}  // namespace tabstijl
+
+#endif  // TABSTIJL_CLI_HPP
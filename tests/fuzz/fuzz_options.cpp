@@ -0,0 +1,69 @@
+// MIT License
+
+// Copyright (c) 2025 Naufal Hanif
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file fuzz_options.cpp
+ *
+ * @brief Fuzz harness of the command-line parser, `parse_options()`.
+ *
+ * An input is split at every '\0' byte into the arguments of a run, which are parsed
+ * into a default configuration. Parsing must either go on or stop with the exit
+ * status 0 (help, version) or 1 (an error), and never crash. The messages it prints
+ * are discarded.
+ *
+ * @author Naufal Hanif
+ * @date 2025
+ */
+
+// The command-line tool is built in, without its entry point
+#define TABSTIJL_NO_MAIN
+
+#include "main.cpp"
+
+#define FUZZ_MAX_ARGUMENTS 64  // Arguments kept from one input, the rest is ignored
+
+extern "C" int LLVMFuzzerTestOneInput(
+    const uint8_t *data,
+    size_t size
+) {
+    // Option errors and the help text are not part of the result
+    static bool is_silenced = (cout.setstate(ios::failbit), cerr.setstate(ios::failbit), true);
+
+    (void)is_silenced;
+
+    string argument_buffer(reinterpret_cast<const char *>(data), size);
+    vector<char *> argument_list = { const_cast<char *>(PROGRAM_NAME) };
+
+    size_t pos = 0;
+
+    do {
+        argument_list.push_back(&argument_buffer[pos]);
+        pos = argument_buffer.find(VOID, pos);
+    } while (pos++ != string::npos && argument_list.size() <= FUZZ_MAX_ARGUMENTS);
+
+    tab_config config = default_config();
+    int exit_status = -1;
+
+    if (!parse_options(static_cast<int>(argument_list.size()), argument_list.data(), config, exit_status) && exit_status != 0 && exit_status != 1) abort();
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+// MIT License
+
+// Copyright (c) 2025 Naufal Hanif
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file fuzz_parse.cpp
+ *
+ * @brief Fuzz harness of the block tokenizer, `parse_block()` and `parse_finish()`.
+ *
+ * The first byte of an input selects the separator and the first line handling, the
+ * second byte the size of the blocks. The rest is tokenized once as a single block and
+ * once block by block, and both runs must produce the same rows. Every block is copied
+ * into its own allocation, freed as soon as it is parsed, so that a row still viewing
+ * a previous block is caught by AddressSanitizer.
+ *
+ * @author Naufal Hanif
+ * @date 2025
+ */
+
+#include "tabstijl.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+using namespace tabstijl;
+
+// Separators selected by the first byte of an input
+static constexpr char SEPARATORS[] = { SPACE, TAB, NEWLINE, VOID };
+
+/**
+ * @brief Tokenizes an input in blocks, copying each row as it completes.
+ *
+ * @param data                The input.
+ * @param size                Number of bytes in the input.
+ * @param block_size          Largest number of bytes given to one `parse_block()` call.
+ * @param col_separator       The column delimiter.
+ * @param exclude_first_line  Whether tokens of the first input line are dropped.
+ *
+ * @return The rows of the input.
+ */
+static vector<vector<string>> parse_rows(
+    const uint8_t *data,
+    const size_t &size,
+    const size_t &block_size,
+    const char &col_separator,
+    const bool &exclude_first_line
+) {
+    tab_parser parser = make_parser(col_separator, exclude_first_line);
+    vector<vector<string>> rows;
+
+    row_handler on_row = [&rows](vector<string_view> &tab_row) {
+        rows.emplace_back(tab_row.begin(), tab_row.end());
+    };
+
+    for (size_t offset = 0; offset < size; offset += block_size) {
+        size_t block_length = min(block_size, size - offset);
+        unique_ptr<char[]> block(new char[block_length]);
+
+        memcpy(block.get(), data + offset, block_length);
+
+        parse_block(parser, block.get(), block_length, on_row);
+    }
+
+    parse_finish(parser, on_row);
+
+    return rows;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(
+    const uint8_t *data,
+    size_t size
+) {
+    if (size < 2) return 0;
+
+    char col_separator = SEPARATORS[data[0] % sizeof(SEPARATORS)];
+    bool exclude_first_line = (data[0] & 0x10) != 0;
+    size_t block_size = data[1] % 64 + 1;
+
+    data += 2;
+    size -= 2;
+
+    // Splitting the input into blocks must not change its rows
+    if (parse_rows(data, size, max<size_t>(size, 1), col_separator, exclude_first_line) != parse_rows(data, size, block_size, col_separator, exclude_first_line)) abort();
+
+    return 0;
+}
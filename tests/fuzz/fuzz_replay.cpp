@@ -0,0 +1,124 @@
+// MIT License
+
+// Copyright (c) 2025 Naufal Hanif
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/**
+ * @file fuzz_replay.cpp
+ *
+ * @brief Runs a fuzz harness over its seed corpus where libFuzzer is not available.
+ *
+ * Every file given on the command line is passed to `LLVMFuzzerTestOneInput()`, then
+ * `FUZZ_REPLAY_MUTATIONS` variants of it, each made by flipping, inserting, erasing or
+ * duplicating random bytes. The variants come from a fixed seed, so every run of
+ * `make test` replays the same inputs. Builds with clang use `make fuzz` instead.
+ *
+ * @author Naufal Hanif
+ * @date 2025
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+
+using namespace std;
+
+#define FUZZ_REPLAY_MUTATIONS 2000  // Variants replayed for each corpus file
+#define FUZZ_REPLAY_SEED 20250101   // Seed of the variants, fixed so that runs are reproducible
+
+// Bytes the separators and options are made of, inserted more often than the others
+static constexpr char DELIMITER_BYTES[] = { '\0', '\t', '\n', ' ', ',', '=', ':', '~', '-' };
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+/**
+ * @brief Passes one input to the harness.
+ *
+ * @param input  The input.
+ */
+static void run_input(const string &input) {
+    LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t *>(input.data()), input.size());
+}
+
+/**
+ * @brief Changes a few random bytes of an input.
+ *
+ * @param input      The input to change.
+ * @param generator  The random generator.
+ */
+static void mutate_input(
+    string &input,
+    mt19937 &generator
+) {
+    size_t edit_count = generator() % 4 + 1;
+
+    for (size_t edit = 0; edit < edit_count; ++edit) {
+        size_t pos = input.empty() ? 0 : generator() % input.size();
+        char byte = generator() % 4 == 0 ? DELIMITER_BYTES[generator() % sizeof(DELIMITER_BYTES)] : static_cast<char>(generator());
+
+        switch (generator() % 4) {
+            case 0: if (!input.empty()) input[pos] = byte; break;
+            case 1: input.insert(pos, 1, byte); break;
+            case 2: if (!input.empty()) input.erase(pos, generator() % 8 + 1); break;
+            default: input.insert(pos, input, pos, generator() % 16 + 1); break;
+        }
+    }
+}
+
+int main(
+    int argc,
+    char *argv[]
+) {
+    mt19937 generator(FUZZ_REPLAY_SEED);
+    size_t input_count = 0;
+
+    for (int index = 1; index < argc; ++index) {
+        ifstream corpus_file(argv[index], ios::binary);
+
+        if (!corpus_file) {
+            cerr << "Error: Unable to read the corpus file '" << argv[index] << "'" << endl;
+
+            return 1;  // Exit with error
+        }
+
+        string corpus_input((istreambuf_iterator<char>(corpus_file)), istreambuf_iterator<char>());
+
+        run_input(corpus_input);
+
+        for (size_t mutation = 0; mutation < FUZZ_REPLAY_MUTATIONS; ++mutation) {
+            string input = corpus_input;
+
+            mutate_input(input, generator);
+            run_input(input);
+        }
+
+        input_count += FUZZ_REPLAY_MUTATIONS + 1;
+    }
+
+    // A harness may have silenced the standard streams
+    cout.clear();
+    cout << "Replayed " << input_count << " inputs" << endl;
+
+    return 0;
+}
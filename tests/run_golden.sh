@@ -0,0 +1,85 @@
+#!/bin/bash
+
+# Runs the golden output cases of tests/golden/cases against a tabstijl binary
+#
+#   tests/run_golden.sh BINARY           compare every case with its golden output
+#   tests/run_golden.sh BINARY --update  rewrite the golden outputs from BINARY
+#
+# Each input is rendered twice, once read from a pipe and once from a regular file
+# (which is memory-mapped), and both tables must match the golden output. Compressed
+# inputs (.gz, .zst) are only detected in regular files, so they are not piped, and
+# their cases are skipped when the format is not built in (WITH_ZLIB, WITH_ZSTD).
+
+BINARY="$1"
+UPDATE="$2"
+
+# Compression formats built in, as given to make
+WITH_ZLIB="${WITH_ZLIB:-1}"
+WITH_ZSTD="${WITH_ZSTD:-0}"
+
+GOLDEN_DIR="$(dirname "$0")/golden"
+
+if [ ! -x "$BINARY" ]; then
+    echo "Error: '$BINARY' is not an executable"
+
+    exit 1
+fi
+
+case_count=0
+failure_count=0
+skip_count=0
+actual_file=$(mktemp)
+
+trap 'rm -f "$actual_file"' EXIT
+
+while read -r name input arguments; do
+    # Skip blank lines and comments
+    [ -z "$name" ] || [ "${name:0:1}" == "#" ] && continue
+
+    read -r -a argument_list <<< "$arguments"
+
+    input_file="$GOLDEN_DIR/input/$input"
+    golden_file="$GOLDEN_DIR/output/$name.out"
+
+    sources="pipe file"
+
+    case "$input" in
+        *.gz) sources="file"; [ "$WITH_ZLIB" == "1" ] || { skip_count=$((skip_count + 1)); continue; } ;;
+        *.zst) sources="file"; [ "$WITH_ZSTD" == "1" ] || { skip_count=$((skip_count + 1)); continue; } ;;
+    esac
+
+    case_count=$((case_count + 1))
+
+    if [ "$UPDATE" == "--update" ]; then
+        "$BINARY" "${argument_list[@]}" < "$input_file" > "$golden_file"
+
+        continue
+    fi
+
+    for source in $sources; do
+        if [ "$source" == "pipe" ]; then
+            cat "$input_file" | "$BINARY" "${argument_list[@]}" > "$actual_file" 2>&1
+        else
+            "$BINARY" "${argument_list[@]}" < "$input_file" > "$actual_file" 2>&1
+        fi
+
+        status=$?
+
+        if [ $status -ne 0 ] || ! cmp -s "$actual_file" "$golden_file"; then
+            failure_count=$((failure_count + 1))
+
+            echo "FAIL: $name ($source, exit status $status)"
+            diff <(cat -v "$golden_file") <(cat -v "$actual_file") | head -n 20
+        fi
+    done
+done < "$GOLDEN_DIR/cases"
+
+if [ "$UPDATE" == "--update" ]; then
+    echo "Updated $case_count golden outputs, skipped $skip_count"
+
+    exit 0
+fi
+
+echo "$case_count golden cases, $failure_count failures, $skip_count skipped"
+
+[ $failure_count -eq 0 ]